@@ -10,7 +10,7 @@
 class CDActionInitialization : public G4VUserActionInitialization
 {
 public:
-  CDActionInitialization(G4String name, CDDetectorConstruction* detector);
+  CDActionInitialization(G4String name, CDDetectorConstruction* detector, G4long seed);
   virtual ~CDActionInitialization();
 
   virtual void BuildForMaster() const;
@@ -19,6 +19,7 @@ public:
 private:
   G4String foutname;
   CDDetectorConstruction* _detector;
+  G4long   fSeed;  // primary pool seed
 };
 
 
@@ -19,6 +19,7 @@ public:
   virtual G4VPhysicalVolume* Construct() override;
   virtual void               ConstructSDandField() override;
   G4String                   DetectorType();
+  G4String                   EmissionMode() const { return fEmission; }
 
   G4double _r_min;
   G4double _r_max;
@@ -35,6 +36,7 @@ private:
 
   G4GenericMessenger*                       fDetectorMessenger = nullptr;
   G4String                                  fSource;
+  G4String                                  fEmission          = "decay";
   G4Cache<CDGasSD*>                         fSD                = nullptr;
 
 };
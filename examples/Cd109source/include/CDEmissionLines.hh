@@ -0,0 +1,40 @@
+#ifndef CDEmissionLines_h
+#define CDEmissionLines_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+/// Cd-109 emission lines
+///
+/// Tabulated electron capture of Cd-109 to Ag-109m and the isomeric
+/// transition of Ag-109m (39.6 s) to the ground state: conversion
+/// electrons, the 88 keV gamma, Ag K and L X-rays and Auger electrons,
+/// with the line energies checked in analyse/analysead.py.
+///
+/// Vacancies left by the capture and by K and L conversion are followed
+/// through the K and L shells, so X-rays and Auger electrons come with
+/// the right coincidences. Emissions from outer shell vacancies (below
+/// 1 keV) and the neutrino are not produced. Times are relative to the
+/// capture; isomeric transition products are delayed by the Ag-109m
+/// lifetime.
+
+class CDEmissionLines
+{
+public:
+  struct Emission
+  {
+    G4bool   gamma;    // photon, else electron
+    G4double energy;
+    G4double time;
+  };
+
+  // one decay, appended to out
+  static void Sample(std::vector<Emission>& out);
+
+private:
+  static void KVacancy(std::vector<Emission>& out, G4double time);
+  static void LVacancy(std::vector<Emission>& out, G4double time);
+};
+
+#endif
@@ -6,6 +6,11 @@
 #include "Randomize.hh"
 #include "globals.hh"
 #include "CDDetectorConstruction.hh"
+#include "CDEmissionLines.hh"
+#include "QTNMPrimaryPool.hh"
+
+#include <vector>
+
 class G4ParticleGun;
 class G4Event;
 
@@ -14,20 +19,33 @@ class G4Event;
 ///
 /// A single particle is generated.
 /// macro commands can change primary properties.
+/// Source positions are sampled for a block of events at a time,
+/// reproducible for a given seed, see QTNMPrimaryPool.
+/// /CD/source/emission lines replaces the Cd-109 ion by its emitted
+/// electrons and photons sampled from CDEmissionLines.
 
 class CDPrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
 public:
-  CDPrimaryGeneratorAction(CDDetectorConstruction* detector);
+  CDPrimaryGeneratorAction(CDDetectorConstruction* detector, G4long seed = 0);
   virtual ~CDPrimaryGeneratorAction();
 
   virtual void GeneratePrimaries(G4Event*);
 
 private:
 
+  void GenerateLines(G4Event* event, const G4ThreeVector& position);
+
   G4ParticleGun*      fParticleGun;
   G4double randomRadiusInShell();
   CDDetectorConstruction* _detector;
+
+  // pre-sampled source positions
+  G4long                fSeed;
+  QTNMPrimaryPool       fPool;
+  G4String              fPoolType;  // source type the pool was filled for
+
+  std::vector<CDEmissionLines::Emission> fEmissions;
 };
 
 #endif
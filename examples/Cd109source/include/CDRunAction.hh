@@ -1,6 +1,8 @@
 #ifndef CDRunAction_h
 #define CDRunAction_h 1
 
+#include "G4Accumulable.hh"
+#include "G4GenericMessenger.hh"
 #include "G4UserRunAction.hh"
 #include "globals.hh"
 
@@ -18,8 +20,23 @@ public:
   virtual void BeginOfRunAction(const G4Run*);
   virtual void EndOfRunAction(const G4Run*);
 
+  // observation time window after the first decay, zero for none
+  G4double GetTimeWindow() const { return fTimeWindow; }
+  void     AddTimeCut(G4double timeSkipped);
+  void     AddTrack(G4int nSteps);
+
 private:
+  void DefineCommands();
+
   G4String         fout;          // output file name
+
+  G4GenericMessenger*      fMessenger   = nullptr;
+  G4double                 fTimeWindow  = 0.;
+  G4String                 fPhaseSpace;   // phase-space file name
+  G4Accumulable<G4int>     fKilled      = 0;
+  G4Accumulable<G4double>  fTimeSkipped = 0.;
+  G4Accumulable<G4int>     fTracked     = 0;
+  G4Accumulable<G4double>  fSteps       = 0.;
 };
 
 
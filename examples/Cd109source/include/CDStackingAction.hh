@@ -0,0 +1,30 @@
+#ifndef CDStackingAction_h
+#define CDStackingAction_h 1
+
+#include "QTNMStackingAction.hh"
+#include "globals.hh"
+
+class CDRunAction;
+
+/// Stacking action class
+///
+/// Applies the observation time window: the window opens with the
+/// decay of the primary ion and any later track, e.g. from the 39.6 s
+/// Ag-109m isomer, is killed before it is tracked. Tracks inside the
+/// window go through the /CD/stack/ rules.
+
+class CDStackingAction : public QTNMStackingAction
+{
+public:
+  CDStackingAction(CDRunAction* runAction);
+  virtual ~CDStackingAction() = default;
+
+  virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track);
+  virtual void PrepareNewEvent();
+
+private:
+  CDRunAction* fRunAction = nullptr;
+  G4double     fStart     = -1.;  // first decay time in this event
+};
+
+#endif
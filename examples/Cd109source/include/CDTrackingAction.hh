@@ -0,0 +1,26 @@
+#ifndef CDTrackingAction_h
+#define CDTrackingAction_h 1
+
+#include "G4UserTrackingAction.hh"
+#include "globals.hh"
+
+class CDRunAction;
+
+/// Tracking action class
+///
+/// Counts steps of tracked particles while a time window is set,
+/// to estimate the steps saved by killing late tracks.
+
+class CDTrackingAction : public G4UserTrackingAction
+{
+public:
+  CDTrackingAction(CDRunAction* runAction);
+  virtual ~CDTrackingAction() = default;
+
+  virtual void PostUserTrackingAction(const G4Track* track);
+
+private:
+  CDRunAction* fRunAction = nullptr;
+};
+
+#endif
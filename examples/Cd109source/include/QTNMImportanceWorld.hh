@@ -0,0 +1,66 @@
+// QTNMImportanceWorld
+//
+//----------------------------------------------------------------------------
+//
+// Parallel world of planar slabs stacked along z, from the emitting source
+// surface towards the detector, for geometric importance biasing of the
+// particles escaping a source.
+//
+// n planes at distances between dmin and dmax above the source surface z
+// = origin (linear or logarithmic spacing, the latter putting thin slabs
+// just above the surface) divide the world into n + 1 cells: everything
+// below the first plane, and one slab above each plane, the last reaching
+// the world boundary. Each cell going up has ratio times the importance of
+// the one below it. Geant4 splits tracks crossing into a cell of higher
+// importance and plays Russian roulette with tracks moving back down,
+// adjusting the track weight so that weighted tallies stay unbiased.
+//
+// Used with G4ImportanceBiasing and G4ParallelWorldPhysics for one particle
+// type, set up in main(). Commands in the given directory configure the
+// slabs before /run/initialize. Outputs without a weight, the phase-space
+// file, must refuse biased jobs (InUse()).
+//
+
+#ifndef QTNMImportanceWorld_h
+#define QTNMImportanceWorld_h 1
+
+#include "G4GenericMessenger.hh"
+#include "G4VUserParallelWorld.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4VPhysicalVolume;
+
+
+class QTNMImportanceWorld : public G4VUserParallelWorld
+{
+public:
+
+  QTNMImportanceWorld(const G4String& worldName, const G4String& commandDir,
+                      G4double origin = 0.);
+  virtual ~QTNMImportanceWorld();
+
+  virtual void Construct();
+  virtual void ConstructSD();
+
+  // an importance world was set up, tracks carry weights
+  static G4bool InUse();
+
+private:
+  void DefineCommands(const G4String& commandDir);
+
+  G4GenericMessenger*             fMessenger = nullptr;
+  G4int                           fPlanes    = 10;
+  G4double                        fOrigin;   // z of the source surface
+  G4double                        fDmin;
+  G4double                        fDmax;
+  G4double                        fRatio     = 2.;
+  G4String                        fSpacing   = "log";
+
+  // cells from below the first plane upward, the world first
+  std::vector<G4VPhysicalVolume*> fCells;
+};
+
+
+#endif
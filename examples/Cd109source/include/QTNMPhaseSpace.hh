@@ -0,0 +1,99 @@
+// QTNMPhaseSpace
+//
+//----------------------------------------------------------------------------
+//
+// Compact binary phase-space files to chain a source simulation into a
+// downstream one without going through ROOT and CSV.
+//
+// A file is a fixed header followed by fixed-size records in Geant4
+// internal units (MeV, mm), native byte order:
+//
+//   header: magic "QTNMPHSP", version, record size, record count
+//   record: event ID, PDG code, kinetic energy, direction, position
+//
+// QTNMPhaseSpaceWriter: the master opens and closes the file around a run,
+// every thread buffers its records and appends them under a mutex when
+// the buffer is full and at the end of the run. Records of one event stay
+// together; events appear in the order their buffers were flushed.
+//
+// QTNMPhaseSpaceReader: maps the file read-only, so worker threads share
+// the page cache instead of holding copies, and hands out records by
+// index, optionally restricted to one PDG code.
+//
+
+#ifndef QTNMPhaseSpace_h
+#define QTNMPhaseSpace_h 1
+
+#include "globals.hh"
+
+#include <cstdint>
+#include <vector>
+
+
+struct QTNMPhaseSpaceHeader
+{
+  char          magic[8];
+  std::uint32_t version;
+  std::uint32_t recordSize;
+  std::uint64_t count;
+};
+
+struct QTNMPhaseSpaceRecord
+{
+  std::int32_t eventID;
+  std::int32_t pdg;
+  double       kine;     // [MeV]
+  double       dir[3];   // unit vector
+  double       pos[3];   // [mm]
+};
+
+
+class QTNMPhaseSpaceWriter
+{
+public:
+
+  // master thread, before and after the event loop
+  static G4bool Open(const G4String& name);
+  static void   Close();
+
+  // any thread, without locking, as often as every event
+  static G4bool IsOpen();
+
+  // any thread, buffered per thread; EndOfEvent() flushes a full buffer,
+  // Flush() whatever is left at the end of the run
+  static void Write(const QTNMPhaseSpaceRecord& record);
+  static void EndOfEvent();
+  static void Flush();
+};
+
+
+class QTNMPhaseSpaceReader
+{
+public:
+
+  explicit QTNMPhaseSpaceReader(const G4String& name);
+  ~QTNMPhaseSpaceReader();
+
+  QTNMPhaseSpaceReader(const QTNMPhaseSpaceReader&)            = delete;
+  QTNMPhaseSpaceReader& operator=(const QTNMPhaseSpaceReader&) = delete;
+
+  // keep records of this PDG code only, 0 for all
+  void SetPDG(G4int pdg);
+
+  std::size_t                 GetEntries() const;
+  const QTNMPhaseSpaceRecord& GetRecord(std::size_t i) const;
+  const G4String&             GetName() const { return fName; }
+
+private:
+  G4String                    fName;
+  int                         fFile    = -1;
+  void*                       fMap     = nullptr;
+  std::size_t                 fMapSize = 0;
+  const QTNMPhaseSpaceRecord* fRecords = nullptr;
+  std::size_t                 fCount   = 0;
+  G4int                       fPDG     = 0;
+  std::vector<std::size_t>    fSelected;
+};
+
+
+#endif
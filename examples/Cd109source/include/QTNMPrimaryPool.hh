@@ -0,0 +1,74 @@
+// QTNMPrimaryPool
+//
+//----------------------------------------------------------------------------
+//
+// Pool of uniform random numbers for the primary generators,
+// drawn a block of events at a time, and branch-free sampling kernels
+// that transform whole arrays so the compiler can vectorise them.
+//
+// The block holding event i is i / size; it is drawn from a private
+// engine seeded with (seed, run, block), and event i uses entry i % size.
+// Primaries hence depend on the seed only, not on which thread processes
+// an event. Threads share the blocks: the first thread to need a block
+// draws its uniforms and transforms them into outputs with the
+// generator's sampler, once, and the others wait for and read the same
+// block. The most recent blocks are kept, so threads interleaving over
+// a block with /run/eventModulo below the pool size do not repeat the work.
+// The sampler settings must hence not change within a run.
+//
+
+#ifndef QTNMPrimaryPool_h
+#define QTNMPrimaryPool_h 1
+
+#include "globals.hh"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+
+class QTNMPrimaryPool
+{
+public:
+
+  struct Block;
+
+  QTNMPrimaryPool(G4int nStreams, G4int nOutputs, G4int size = 4096);
+  ~QTNMPrimaryPool();
+
+  void  SetSize(G4int size);
+  G4int GetSize() const { return fSize; }
+
+  // make the block holding eventID current, true if it changed; sample()
+  // fills Outputs() from Uniforms() if no thread has done so for the block
+  G4bool Fill(G4long seed, G4int runID, G4long eventID,
+              const std::function<void()>& sample);
+  void   Invalidate();
+
+  G4int           Slot(G4long eventID) const { return (G4int) (eventID % fSize); }
+  const G4double* Uniforms(G4int stream) const;
+  G4double*       Outputs(G4int k);  // in sample() only
+  G4double        Output(G4int k, G4long eventID) const;
+
+  // sampling kernels, n values each
+  static void Gauss(G4int n, const G4double* u1, const G4double* u2,
+                    G4double mean, G4double sigma, G4double* out);
+  static void Disk(G4int n, const G4double* u1, const G4double* u2,
+                   G4double radius, G4double* x, G4double* y);
+  static void ShellRadius(G4int n, const G4double* u, G4double rmin,
+                          G4double rmax, G4double* r);
+  static void Isotropic(G4int n, const G4double* u1, const G4double* u2,
+                        G4double* dx, G4double* dy, G4double* dz);
+
+private:
+  G4int                  fStreams;
+  G4int                  fOutputs;
+  G4int                  fSize;
+  G4long                 fSeed  = 0;
+  G4int                  fRun   = -1;
+  G4long                 fBlock = -1;
+  std::shared_ptr<Block> fCurrent;  // shared with other threads
+};
+
+
+#endif
@@ -2,12 +2,17 @@
 #include "CDEventAction.hh"
 #include "CDPrimaryGeneratorAction.hh"
 #include "CDRunAction.hh"
+#include "CDStackingAction.hh"
+#include "CDTrackingAction.hh"
+#include "QTNMStepMonitor.hh"
 
 
-CDActionInitialization::CDActionInitialization(G4String name, CDDetectorConstruction* detector)
+CDActionInitialization::CDActionInitialization(G4String name, CDDetectorConstruction* detector,
+                                               G4long seed)
 : G4VUserActionInitialization()
 , foutname(std::move(name))
 , _detector(detector)
+, fSeed(seed)
 {}
 
 CDActionInitialization::~CDActionInitialization() = default;
@@ -20,8 +25,12 @@ void CDActionInitialization::BuildForMaster() const
 void CDActionInitialization::Build() const
 {
   // forward detector
-  SetUserAction(new CDPrimaryGeneratorAction(_detector));
+  SetUserAction(new CDPrimaryGeneratorAction(_detector, fSeed));
   auto event = new CDEventAction;
   SetUserAction(event);
-  SetUserAction(new CDRunAction(foutname));
+  auto run = new CDRunAction(foutname);
+  SetUserAction(run);
+  SetUserAction(new CDStackingAction(run));
+  SetUserAction(new CDTrackingAction(run));
+  if(QTNMStepMonitor::IsEnabled()) SetUserAction(new QTNMStepMonitor);
 }
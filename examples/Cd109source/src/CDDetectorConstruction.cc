@@ -397,4 +397,12 @@ void CDDetectorConstruction::DefineCommands()
     .SetGuidance("Set source choice string: Isotrak; QSA; Pointlike; Shell.")
     .SetStates(G4State_PreInit)
     .SetToBeBroadcasted(false);
+
+  // emission command, read by the primary generator
+  fDetectorMessenger->DeclareProperty("emission", fEmission)
+    .SetGuidance("Primary emission: decay, a Cd-109 ion decayed by Geant4;")
+    .SetGuidance("lines, tabulated Cd-109 / Ag-109m emission lines directly.")
+    .SetCandidates("decay lines")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
 }
@@ -0,0 +1,106 @@
+#include "CDEmissionLines.hh"
+
+#include <cmath>
+
+#include "Randomize.hh"
+#include "G4SystemOfUnits.hh"
+
+namespace
+{
+  struct Line
+  {
+    G4double intensity;   // relative
+    G4double energy;      // [keV]
+    G4bool   gamma;
+    G4int    vacancy;     // shell left open: 0 none, 1 K, 2 L
+  };
+
+  // index of a line with probability proportional to its intensity
+  template <std::size_t N>
+  std::size_t Pick(const Line (&lines)[N])
+  {
+    G4double total = 0.;
+    for(const auto& l : lines) total += l.intensity;
+
+    G4double u = total * G4UniformRand();
+    for(std::size_t i = 0; i < N - 1; ++i)
+    {
+      u -= lines[i].intensity;
+      if(u < 0.) return i;
+    }
+    return N - 1;
+  }
+
+  // electron capture, per shell; the neutrino is not produced
+  const Line kCapture[] = {
+    { 0.812, 0., false, 1 },
+    { 0.151, 0., false, 2 },
+    { 0.037, 0., false, 0 }
+  };
+
+  // Ag-109m isomeric transition, per 100 decays
+  const Line kTransition[] = {
+    { 41.8,  62.5196, false, 1 },   // ce-K
+    { 44.3,  84.2278, false, 2 },   // ce-L
+    {  9.07, 87.3161, false, 0 },   // ce-M
+    {  1.62, 87.9384, false, 0 },   // ce-N
+    {  3.66, 88.0336, true,  0 }    // gamma
+  };
+
+  // Ag K X-rays, per 100 K vacancies filled radiatively;
+  // K-alpha leaves an L vacancy, K-beta outer shell vacancies
+  const Line kKXray[] = {
+    { 29.5,  21.99,  true, 2 },   // K-alpha2
+    { 55.7,  22.163, true, 2 },   // K-alpha1
+    {  4.76, 24.912, true, 0 },   // K-beta3
+    {  9.2,  24.943, true, 0 },   // K-beta1
+    {  2.3,  25.455, true, 0 }    // K-beta2
+  };
+
+  const G4double kOmegaK     = 0.83;    // Ag K fluorescence yield
+  const G4double kOmegaL     = 0.056;   // Ag L fluorescence yield
+  const G4double kKAuger     = 18.5;    // [keV], KLL
+  const G4double kLAuger     = 2.61;    // [keV]
+  const G4double kLXray      = 2.98;    // [keV], L-alpha
+  const G4double kHalfLife   = 39.6 * s;  // Ag-109m
+}
+
+void CDEmissionLines::Sample(std::vector<Emission>& out)
+{
+  // capture at t = 0
+  const auto& capture = kCapture[Pick(kCapture)];
+  if(capture.vacancy == 1) KVacancy(out, 0.);
+  if(capture.vacancy == 2) LVacancy(out, 0.);
+
+  // isomeric transition
+  G4double time = G4RandExponential::shoot(kHalfLife / std::log(2.));
+  const auto& line = kTransition[Pick(kTransition)];
+  out.push_back({ line.gamma, line.energy * keV, time });
+  if(line.vacancy == 1) KVacancy(out, time);
+  if(line.vacancy == 2) LVacancy(out, time);
+}
+
+void CDEmissionLines::KVacancy(std::vector<Emission>& out, G4double time)
+{
+  if(G4UniformRand() < kOmegaK)
+  {
+    const auto& xray = kKXray[Pick(kKXray)];
+    out.push_back({ true, xray.energy * keV, time });
+    if(xray.vacancy == 2) LVacancy(out, time);
+  }
+  else
+  {
+    // KLL Auger electron leaves two L vacancies
+    out.push_back({ false, kKAuger * keV, time });
+    LVacancy(out, time);
+    LVacancy(out, time);
+  }
+}
+
+void CDEmissionLines::LVacancy(std::vector<Emission>& out, G4double time)
+{
+  if(G4UniformRand() < kOmegaL)
+    out.push_back({ true, kLXray * keV, time });
+  else
+    out.push_back({ false, kLAuger * keV, time });
+}
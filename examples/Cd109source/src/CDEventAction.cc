@@ -8,6 +8,9 @@
 #include "G4SDManager.hh"
 #include "G4UnitsTable.hh"
 #include "G4ios.hh"
+#include "QTNMEventSeeding.hh"
+#include "QTNMPhaseSpace.hh"
+#include "QTNMTelemetry.hh"
 #include "CDGasSD.hh"
 
 
@@ -36,6 +39,9 @@ void CDEventAction::BeginOfEventAction(const G4Event*
 
 void CDEventAction::EndOfEventAction(const G4Event* event)
 {
+  // progress, instead of printing every event
+  QTNMTelemetry::EndOfEvent();
+
   // Get GAS hits collections IDs
   if(fGID < 0)
     fGID = G4SDManager::GetSDMpointer()->GetCollectionID("GasHitsCollection");
@@ -50,7 +56,7 @@ void CDEventAction::EndOfEventAction(const G4Event* event)
   }
 
   // dummy storage
-  std::vector<G4double> tkine, px, py, pz, posx, posy, posz;
+  std::vector<G4double> tkine, px, py, pz, posx, posy, posz, weight;
   std::vector<G4int> tid, tpdg;
 
   // get analysis manager
@@ -83,10 +89,11 @@ void CDEventAction::EndOfEventAction(const G4Event* event)
     posx.push_back(lx);
     posy.push_back(ly);
     posz.push_back(lz);
+    weight.push_back(hh->GetWeight());
   }
 
   // fill the ntuple - check column id?
-  G4int eventID = event->GetEventID();
+  G4int eventID = (G4int) QTNMEventSeeding::EventID(event);
   for ( G4int i=0; i<tkine.size(); i++)
   {
     analysisManager->FillNtupleIColumn(0, eventID); // repeat all rows
@@ -99,9 +106,31 @@ void CDEventAction::EndOfEventAction(const G4Event* event)
     analysisManager->FillNtupleDColumn(7, posx.at(i));
     analysisManager->FillNtupleDColumn(8, posy.at(i));
     analysisManager->FillNtupleDColumn(9, posz.at(i));
+    analysisManager->FillNtupleDColumn(10, weight.at(i));
     analysisManager->AddNtupleRow();
   }
 
+  // phase-space output, internal units
+  if(QTNMPhaseSpaceWriter::IsOpen())
+  {
+    for ( G4int i=0; i<GnofHits; i++ )
+    {
+      auto hh = (*GasHC)[i];
+      QTNMPhaseSpaceRecord record;
+      record.eventID = eventID;
+      record.pdg     = (G4int) hh->GetPDG();
+      record.kine    = hh->GetKine();
+      record.dir[0]  = hh->GetPx();
+      record.dir[1]  = hh->GetPy();
+      record.dir[2]  = hh->GetPz();
+      record.pos[0]  = hh->GetPosx();
+      record.pos[1]  = hh->GetPosy();
+      record.pos[2]  = hh->GetPosz();
+      QTNMPhaseSpaceWriter::Write(record);
+    }
+    QTNMPhaseSpaceWriter::EndOfEvent();
+  }
+
   // printing
   // G4cout << ">>> Event: " << eventID << G4endl;
   // G4cout << "    " << GnofHits << " gas hits stored in this event." << G4endl;
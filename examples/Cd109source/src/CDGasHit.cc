@@ -12,7 +12,8 @@ CDGasHit::CDGasHit()
    fPz(0.),
    fPosx(0.),
    fPosy(0.),
-   fPosz(0.)
+   fPosz(0.),
+   fWeight(1.)
 {}
 
 CDGasHit::~CDGasHit() {}
@@ -29,6 +30,7 @@ CDGasHit::CDGasHit(const CDGasHit& right)
   fPosx         = right.fPosx;
   fPosy         = right.fPosy;
   fPosz         = right.fPosz;
+  fWeight       = right.fWeight;
 }
 
 const CDGasHit& CDGasHit::operator=(const CDGasHit& right)
@@ -42,6 +44,7 @@ const CDGasHit& CDGasHit::operator=(const CDGasHit& right)
   fPosx         = right.fPosx;
   fPosy         = right.fPosy;
   fPosz         = right.fPosz;
+  fWeight       = right.fWeight;
 
   return *this;
 }
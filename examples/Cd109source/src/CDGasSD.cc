@@ -56,6 +56,7 @@ G4bool CDGasSD::ProcessHits(G4Step* aStep,
   newHit->SetPosx(postloc.x());
   newHit->SetPosy(postloc.y());
   newHit->SetPosz(postloc.z());
+  newHit->SetWeight(aStep->GetTrack()->GetWeight());
 
   fHitsCollection->insert( newHit );
 
@@ -2,28 +2,39 @@
 #include "CDPrimaryGeneratorAction.hh"
 #include "CDDetectorConstruction.hh"
 #include "CDActionInitialization.hh"
+#include "CDEmissionLines.hh"
+#include "QTNMEventSeeding.hh"
 
 //maths
+#include <algorithm>
 #include <cmath>
 
 // geant
 #include "G4Event.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
 #include "G4ThreeVector.hh"
 #include "G4TwoVector.hh"
 #include "G4ParticleDefinition.hh"
+#include "G4Gamma.hh"
+#include "G4Electron.hh"
 #include "G4IonTable.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4RandomDirection.hh"
 #include "G4ParticleGun.hh"
 #include "G4ParticleTable.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4LogicalVolumeStore.hh"
 #include "G4LogicalVolume.hh"
-#include "G4RandomTools.hh"
 
 
-CDPrimaryGeneratorAction::CDPrimaryGeneratorAction(CDDetectorConstruction* detector)
+CDPrimaryGeneratorAction::CDPrimaryGeneratorAction(CDDetectorConstruction* detector, G4long seed)
 : G4VUserPrimaryGeneratorAction()
 , fParticleGun(nullptr)
 , _detector(detector)
+, fSeed(seed)
+, fPool(3, 3)  // radius and direction, or spot; x, y, z
 {
   G4int nofParticles = 1;
   fParticleGun       = new G4ParticleGun(nofParticles);
@@ -40,42 +51,104 @@ CDPrimaryGeneratorAction::~CDPrimaryGeneratorAction()
 
 void CDPrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
 {
-  // set Cd-109 as default ion
-  G4int Z = 48;
-  G4int A = 109;
-  G4ParticleDefinition* ion = G4IonTable::GetIonTable()->GetIon(Z,A,0.*keV);
-  fParticleGun->SetParticleDefinition(ion);
-  fParticleGun->SetParticleCharge(0.*eplus);
+  // random numbers of this event independent of thread and job
+  QTNMEventSeeding::SeedEvent(event);
 
   G4String detectorType = _detector->DetectorType();
+  G4bool pancake = (detectorType == "Isotrak" || detectorType == "QSA");
+  G4bool sphere  = (detectorType == "Pointlike" || detectorType == "Shell");
+  if (!pancake && !sphere)
+    {
+      G4ExceptionDescription msg;
+      msg << "Unknown source type " << detectorType << ", no source geometry.";
+      G4Exception("CDPrimaryGeneratorAction::GeneratePrimaries()", "CD0001",
+                  FatalException, msg);
+      return;
+    }
+  if (detectorType != fPoolType)
+    {
+      fPool.Invalidate();
+      fPoolType = detectorType;
+    }
 
-  if (detectorType == "Isotrak" || detectorType == "QSA")
+  // pool block of this event, sampled once by the first thread to need it
+  G4long eventID = QTNMEventSeeding::EventID(event);
+  auto   runManager = G4RunManager::GetRunManager();
+  G4int  runID = (runManager && runManager->GetCurrentRun())
+                 ? runManager->GetCurrentRun()->GetRunID() : 0;
+  fPool.Fill(fSeed, runID, eventID, [this, pancake]()
     {
-      // Pancake-shape source geometry (for Isotrak and QSA)
+      G4int n = fPool.GetSize();
+      G4double* x = fPool.Outputs(0);
+      G4double* y = fPool.Outputs(1);
+      G4double* z = fPool.Outputs(2);
 
-      G4double fSpot = 5.0*mm; // Fixed spot diameter for each source
+      if (pancake)
+        {
+          // Pancake-shape source geometry (for Isotrak and QSA)
+          G4double fSpot = 5.0*mm; // Fixed spot diameter for each source
 
-      // Generate a random point in a circle
-      G4TwoVector spot = G4RandomPointInEllipse(fSpot/2.0, fSpot/2.0); // circle
-      G4ThreeVector loc(spot.x(), spot.y(), 0.0); // at z = 0
+          // Random points in a circle at z = 0
+          QTNMPrimaryPool::Disk(n, fPool.Uniforms(0), fPool.Uniforms(1), fSpot/2.0, x, y);
+          std::fill(z, z + n, 0.);
+        }
+      else
+        {
+          // Spherical-shape source geometry (for Pointlike and Shell):
+          // random radius in the shell volume, random point on that sphere
+          std::vector<G4double> r(n);
+          QTNMPrimaryPool::ShellRadius(n, fPool.Uniforms(0), _detector->_r_min,
+                                       _detector->_r_max, r.data());
+          QTNMPrimaryPool::Isotropic(n, fPool.Uniforms(1), fPool.Uniforms(2), x, y, z);
+          for (G4int i = 0; i < n; ++i)
+            {
+              x[i] *= r[i];
+              y[i] *= r[i];
+              z[i] *= r[i];
+            }
+        }
+    });
+  G4ThreeVector position(fPool.Output(0, eventID), fPool.Output(1, eventID),
+                         fPool.Output(2, eventID));
 
-      fParticleGun->SetParticlePosition(G4ThreeVector(loc.x()/mm, loc.y()/mm, 0)); // at z=0
-      fParticleGun->GeneratePrimaryVertex(event); // Generate primary vertex
-    }
-  else if (detectorType == "Pointlike" || detectorType == "Shell")
+  if (_detector->EmissionMode() == "lines")
     {
-      // Spherical-shape source geometry (for Pointlike and Shell)
-      G4double rnd = G4UniformRand();
+      GenerateLines(event, position);
+      return;
+    }
 
-      G4double rmax3 = std::pow(_detector->_r_max, 3);
-      G4double rmin3 = std::pow(_detector->_r_min, 3);
-      G4double m = (rmax3 - rmin3) * rnd + rmin3;
-      G4double r = std::pow(m, 1.0/3.0); // Randomly generated radius
+  // set Cd-109 as default ion
+  G4int Z = 48;
+  G4int A = 109;
+  G4ParticleDefinition* ion = G4IonTable::GetIonTable()->GetIon(Z,A,0.*keV);
+  fParticleGun->SetParticleDefinition(ion);
+  fParticleGun->SetParticleCharge(0.*eplus);
 
-      // Generate a random point on a sphere with radius r
-      G4ThreeVector loc = G4RandomPointOnEllipsoid(r, r, r);
+  fParticleGun->SetParticlePosition(position);
+  fParticleGun->GeneratePrimaryVertex(event); // Generate primary vertex
+}
+
+void CDPrimaryGeneratorAction::GenerateLines(G4Event* event, const G4ThreeVector& position)
+{
+  // emitted particles directly, isotropic and uncorrelated in direction;
+  // one vertex for the capture and one for the delayed isomeric transition
+  fEmissions.clear();
+  CDEmissionLines::Sample(fEmissions);
+
+  G4PrimaryVertex* vertex = nullptr;
+  for (const auto& emission : fEmissions)
+    {
+      if (!vertex || vertex->GetT0() != emission.time)
+        {
+          vertex = new G4PrimaryVertex(position, emission.time);
+          event->AddPrimaryVertex(vertex);
+        }
+      G4ParticleDefinition* definition = G4Electron::Definition();
+      if (emission.gamma) definition = G4Gamma::Definition();
 
-      fParticleGun->SetParticlePosition(G4ThreeVector(loc.x()/mm, loc.y()/mm, loc.z()/mm));
-      fParticleGun->GeneratePrimaryVertex(event); // Generate primary vertex
+      auto particle = new G4PrimaryParticle(definition);
+      particle->SetKineticEnergy(emission.energy);
+      particle->SetMomentumDirection(G4RandomDirection());
+      vertex->SetPrimary(particle);
     }
 }
@@ -1,10 +1,16 @@
 #include "CDRunAction.hh"
 
+#include "G4AccumulableManager.hh"
 #include "G4Run.hh"
 #include "G4RunManager.hh"
 #include "G4AnalysisManager.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4UnitsTable.hh"
+#include "QTNMImportanceWorld.hh"
+#include "QTNMPhaseSpace.hh"
+#include "QTNMStackingAction.hh"
+#include "QTNMStepMonitor.hh"
+#include "QTNMTelemetry.hh"
 
 CDRunAction::CDRunAction(G4String name)
 : G4UserRunAction()
@@ -31,21 +37,64 @@ CDRunAction::CDRunAction(G4String name)
   analysisManager->CreateNtupleDColumn("Posx");
   analysisManager->CreateNtupleDColumn("Posy");
   analysisManager->CreateNtupleDColumn("Posz");
+  analysisManager->CreateNtupleDColumn("Weight");
   analysisManager->FinishNtuple();
 
+  // Time window statistics
+  auto accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->RegisterAccumulable(fKilled);
+  accumulableManager->RegisterAccumulable(fTimeSkipped);
+  accumulableManager->RegisterAccumulable(fTracked);
+  accumulableManager->RegisterAccumulable(fSteps);
+
+  DefineCommands();
 }
 
 // run manager deletes analysis manager, example AnaEx01
-CDRunAction::~CDRunAction() = default;
+CDRunAction::~CDRunAction()
+{
+  delete fMessenger;
+}
+
+void CDRunAction::AddTimeCut(G4double timeSkipped)
+{
+  fKilled      += 1;
+  fTimeSkipped += timeSkipped;
+}
 
-void CDRunAction::BeginOfRunAction(const G4Run* /*run*/)
+void CDRunAction::AddTrack(G4int nSteps)
 {
+  fTracked += 1;
+  fSteps   += nSteps;
+}
+
+void CDRunAction::BeginOfRunAction(const G4Run* run)
+{
+  // progress and throughput, workers only count events
+  if(IsMaster()) QTNMTelemetry::BeginOfRun(run->GetNumberOfEventToBeProcessed());
+
+  G4AccumulableManager::Instance()->Reset();
+
   // Get analysis manager
   auto analysisManager = G4AnalysisManager::Instance();
 
   // Open an output file
   //
   analysisManager->OpenFile(fout);
+
+  // phase-space file, shared by all threads; its records carry no weight,
+  // so a replay of a biased run would give biased spectra
+  if(IsMaster() && !fPhaseSpace.empty() && fPhaseSpace != "none")
+  {
+    if(QTNMImportanceWorld::InUse())
+    {
+      G4ExceptionDescription msg;
+      msg << "Phase-space file " << fPhaseSpace << " requested in an importance-biased job;"
+          << " run without --importance to write one.";
+      G4Exception("CDRunAction::BeginOfRunAction()", "CD0002", FatalErrorInArgument, msg);
+    }
+    QTNMPhaseSpaceWriter::Open(fPhaseSpace);
+  }
 }
 
 void CDRunAction::EndOfRunAction(const G4Run* /*run*/)
@@ -57,4 +106,45 @@ void CDRunAction::EndOfRunAction(const G4Run* /*run*/)
   //
   analysisManager->Write();
   analysisManager->CloseFile();
+
+  // workers end their runs before the master
+  QTNMPhaseSpaceWriter::Flush();
+  if(IsMaster()) QTNMPhaseSpaceWriter::Close();
+
+  // stacking rule counts and step statistics, merged as above
+  QTNMStackingAction::Flush();
+  if(IsMaster()) QTNMStackingAction::Report();
+  QTNMStepMonitor::Flush();
+  if(IsMaster()) QTNMStepMonitor::Report();
+
+  if(IsMaster()) QTNMTelemetry::EndOfRun("none");
+
+  // Time window report, merged over threads
+  G4AccumulableManager::Instance()->Merge();
+  if(IsMaster() && fTimeWindow > 0.)
+  {
+    G4double meanSteps = (fTracked.GetValue() > 0)
+      ? fSteps.GetValue() / fTracked.GetValue() : 0.;
+    G4cout << ">>> Time window " << G4BestUnit(fTimeWindow, "Time") << ": "
+           << fKilled.GetValue() << " late tracks killed, "
+           << G4BestUnit(fTimeSkipped.GetValue(), "Time")
+           << " of decay time skipped (summed over killed tracks), estimated "
+           << fKilled.GetValue() * meanSteps << " steps saved." << G4endl;
+  }
+}
+
+void CDRunAction::DefineCommands()
+{
+  // Define /CD/run command directory using generic messenger class
+  fMessenger = new G4GenericMessenger(this, "/CD/run/", "Run control");
+
+  auto& windowCmd = fMessenger->DeclarePropertyWithUnit("timeWindow", "ns", fTimeWindow,
+                                                        "Kill tracks later than this after the first decay, 0 for none.");
+  windowCmd.SetParameterName("t", false);
+  windowCmd.SetRange("t>=0.");
+  windowCmd.SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("phaseSpace", fPhaseSpace,
+                              "Also write scored particles to this phase-space file, none to stop.")
+    .SetStates(G4State_PreInit, G4State_Idle);
 }
@@ -0,0 +1,38 @@
+#include "CDStackingAction.hh"
+#include "CDRunAction.hh"
+
+#include "G4ParticleDefinition.hh"
+#include "G4Track.hh"
+
+
+CDStackingAction::CDStackingAction(CDRunAction* runAction)
+: QTNMStackingAction("/CD/stack/")
+, fRunAction(runAction)
+{}
+
+G4ClassificationOfNewTrack CDStackingAction::ClassifyNewTrack(const G4Track* track)
+{
+  G4double window = fRunAction->GetTimeWindow();
+  if(window <= 0.) return QTNMStackingAction::ClassifyNewTrack(track);
+
+  // the window opens with the first secondaries from the decay of the
+  // primary ion, or at the capture (t = 0) for primaries emitted directly
+  // with /CD/source/emission lines
+  G4bool primary = (track->GetParentID() == 0);
+  if(primary && track->GetDefinition()->IsGeneralIon()) return fUrgent;
+
+  if(fStart < 0.) fStart = primary ? 0. : track->GetGlobalTime();
+
+  G4double late = track->GetGlobalTime() - (fStart + window);
+  if(late > 0.)
+  {
+    fRunAction->AddTimeCut(late);
+    return fKill;
+  }
+  return QTNMStackingAction::ClassifyNewTrack(track);
+}
+
+void CDStackingAction::PrepareNewEvent()
+{
+  fStart = -1.;
+}
@@ -0,0 +1,16 @@
+#include "CDTrackingAction.hh"
+#include "CDRunAction.hh"
+
+#include "G4Track.hh"
+
+
+CDTrackingAction::CDTrackingAction(CDRunAction* runAction)
+: G4UserTrackingAction()
+, fRunAction(runAction)
+{}
+
+void CDTrackingAction::PostUserTrackingAction(const G4Track* track)
+{
+  if(fRunAction->GetTimeWindow() > 0.)
+    fRunAction->AddTrack(track->GetCurrentStepNumber());
+}
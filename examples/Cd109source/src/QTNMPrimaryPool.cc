@@ -0,0 +1,162 @@
+// QTNMPrimaryPool
+//
+//----------------------------------------------------------------------------
+//
+
+#include "QTNMPrimaryPool.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <tuple>
+
+#include "CLHEP/Random/MixMaxRng.h"
+#include "G4AutoLock.hh"
+#include "G4PhysicalConstants.hh"
+
+
+struct QTNMPrimaryPool::Block
+{
+  std::vector<G4double> uniform;  // streams * size
+  std::vector<G4double> output;   // outputs * size
+  std::once_flag        sampled;
+};
+
+namespace
+{
+  // (seed, run, block, streams, outputs, size)
+  using Key = std::tuple<G4long, G4int, G4long, G4int, G4int, G4int>;
+
+  // most recent blocks of all threads, oldest first; threads work on
+  // neighbouring blocks, so a few cover all of them
+  const std::size_t kCachedBlocks = 16;
+  G4Mutex           poolMutex = G4MUTEX_INITIALIZER;
+  std::deque<std::pair<Key, std::shared_ptr<QTNMPrimaryPool::Block>>> cache;
+}
+
+QTNMPrimaryPool::QTNMPrimaryPool(G4int nStreams, G4int nOutputs, G4int size)
+  : fStreams(nStreams), fOutputs(nOutputs), fSize(size)
+{}
+
+QTNMPrimaryPool::~QTNMPrimaryPool() = default;
+
+void QTNMPrimaryPool::SetSize(G4int size)
+{
+  if(size <= 0 || size == fSize) return;
+  fSize = size;
+  Invalidate();
+}
+
+void QTNMPrimaryPool::Invalidate()
+{
+  fCurrent.reset();
+  fBlock = -1;
+}
+
+G4bool QTNMPrimaryPool::Fill(G4long seed, G4int runID, G4long eventID,
+                             const std::function<void()>& sample)
+{
+  G4long block = eventID / fSize;
+  if(fCurrent && block == fBlock && runID == fRun && seed == fSeed) return false;
+
+  fSeed  = seed;
+  fRun   = runID;
+  fBlock = block;
+
+  // shared block, created by the first thread to need it
+  Key key(seed, runID, block, fStreams, fOutputs, fSize);
+  {
+    G4AutoLock lock(&poolMutex);
+    auto it = std::find_if(cache.begin(), cache.end(),
+                           [&key](const auto& entry) { return entry.first == key; });
+    if(it != cache.end())
+      fCurrent = it->second;
+    else
+    {
+      fCurrent = std::make_shared<Block>();
+      cache.emplace_back(key, fCurrent);
+      if(cache.size() > kCachedBlocks) cache.pop_front();
+    }
+  }
+
+  // drawn and sampled once, other threads wait here for the outputs
+  std::call_once(fCurrent->sampled, [&]()
+  {
+    // independent MixMax stream per (seed, run, block)
+    long seeds[4] = { (long) seed, (long) runID, (long) block, 0 };
+    CLHEP::MixMaxRng engine;
+    engine.setSeeds(seeds, 4);
+    fCurrent->uniform.resize(fStreams * fSize);
+    fCurrent->output.resize(fOutputs * fSize);
+    engine.flatArray((G4int) fCurrent->uniform.size(), fCurrent->uniform.data());
+    sample();
+  });
+  return true;
+}
+
+const G4double* QTNMPrimaryPool::Uniforms(G4int stream) const
+{
+  return fCurrent->uniform.data() + stream * fSize;
+}
+
+G4double* QTNMPrimaryPool::Outputs(G4int k)
+{
+  return fCurrent->output.data() + k * fSize;
+}
+
+G4double QTNMPrimaryPool::Output(G4int k, G4long eventID) const
+{
+  return fCurrent->output[k * fSize + Slot(eventID)];
+}
+
+void QTNMPrimaryPool::Gauss(G4int n, const G4double* u1, const G4double* u2,
+                            G4double mean, G4double sigma, G4double* out)
+{
+  // Box-Muller, cosine branch only
+  for(G4int i = 0; i < n; ++i)
+  {
+    G4double r = std::sqrt(-2. * std::log(std::max(u1[i], DBL_MIN)));
+    out[i] = mean + sigma * r * std::cos(twopi * u2[i]);
+  }
+}
+
+void QTNMPrimaryPool::Disk(G4int n, const G4double* u1, const G4double* u2,
+                           G4double radius, G4double* x, G4double* y)
+{
+  // uniform in a disk by inversion, no rejection loop
+  for(G4int i = 0; i < n; ++i)
+  {
+    G4double r   = radius * std::sqrt(u1[i]);
+    G4double phi = twopi * u2[i];
+    x[i] = r * std::cos(phi);
+    y[i] = r * std::sin(phi);
+  }
+}
+
+void QTNMPrimaryPool::ShellRadius(G4int n, const G4double* u, G4double rmin,
+                                  G4double rmax, G4double* r)
+{
+  // uniform in volume between rmin and rmax
+  G4double rmin3 = rmin * rmin * rmin;
+  G4double rmax3 = rmax * rmax * rmax;
+  for(G4int i = 0; i < n; ++i)
+  {
+    r[i] = std::cbrt(rmin3 + (rmax3 - rmin3) * u[i]);
+  }
+}
+
+void QTNMPrimaryPool::Isotropic(G4int n, const G4double* u1, const G4double* u2,
+                                G4double* dx, G4double* dy, G4double* dz)
+{
+  for(G4int i = 0; i < n; ++i)
+  {
+    G4double cost = 1. - 2. * u1[i];
+    G4double sint = std::sqrt(std::max(0., 1. - cost * cost));
+    G4double phi  = twopi * u2[i];
+    dx[i] = sint * std::cos(phi);
+    dy[i] = sint * std::sin(phi);
+    dz[i] = cost;
+  }
+}
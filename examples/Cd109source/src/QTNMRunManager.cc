@@ -0,0 +1,72 @@
+// QTNMRunManager
+//
+//----------------------------------------------------------------------------
+//
+
+#include "QTNMRunManager.hh"
+
+#include <algorithm>
+
+#include "CLI11.hpp"
+#include "G4MTRunManager.hh"
+#include "G4RunManager.hh"
+#include "G4RunManagerFactory.hh"
+#include "G4TaskRunManager.hh"
+#include "G4Threading.hh"
+#include "G4ios.hh"
+
+
+void QTNMRunManager::AddOptions(CLI::App& app)
+{
+  app.add_option("--runManager", type, "<default|serial|mt|tasking> Default: default")
+    ->check(CLI::IsMember({ "default", "serial", "mt", "tasking" }));
+  app.add_option("-t, --nthreads", nthreads,
+                 "<number of threads to use, 0 for all cores> Default: 4");
+  app.add_flag("--oversubscribe", oversubscribe, "Allow more threads than cores");
+  app.add_option("--eventModulo", eventModulo,
+                 "<events per batch sent to a thread, 0 automatic> Default: 0");
+  app.add_option("--seedOnce", seedOnce,
+                 "<0: seed every event, 1: every batch, 2: once per run> Default: 0")
+    ->check(CLI::Range(0, 2));
+  app.add_option("--grainsize", grainsize,
+                 "<tasking: events per task, 0 for the Geant4 default> Default: 0");
+}
+
+G4RunManager* QTNMRunManager::Create() const
+{
+  G4RunManagerType managerType = G4RunManagerType::Default;
+  if(type == "serial")
+    managerType = G4RunManagerType::Serial;
+  else if(type == "mt")
+    managerType = G4RunManagerType::MT;
+  else if(type == "tasking")
+    managerType = G4RunManagerType::Tasking;
+
+  auto* runManager = G4RunManagerFactory::CreateRunManager(managerType);
+
+  // serial unless the factory gave a multi-threaded one
+  auto* mtManager = dynamic_cast<G4MTRunManager*>(runManager);
+  if(!mtManager)
+  {
+    G4cout << "      ********* Run Manager constructed in sequential mode ***** " << G4endl;
+    return runManager;
+  }
+
+  G4int cores   = G4Threading::G4GetNumberOfCores();
+  G4int nthread = (nthreads > 0) ? nthreads : cores;
+  if(!oversubscribe) nthread = std::min(nthread, cores);  // limit to the machine
+  mtManager->SetNumberOfThreads(nthread);
+
+  if(eventModulo > 0) mtManager->SetEventModulo(eventModulo);
+  G4MTRunManager::SetSeedOncePerCommunication(seedOnce);
+
+  auto* taskManager = dynamic_cast<G4TaskRunManager*>(runManager);
+  if(taskManager && grainsize > 0) taskManager->SetGrainsize(grainsize);
+
+  G4cout << "      ********* Run Manager constructed in " << (taskManager ? "tasking" : "MT")
+         << " mode: " << nthread << " threads, event modulo "
+         << (eventModulo > 0 ? std::to_string(eventModulo) : std::string("automatic"))
+         << ", seed once per " << (seedOnce == 0 ? "event" : seedOnce == 1 ? "batch" : "run")
+         << " ***** " << G4endl;
+  return runManager;
+}
@@ -0,0 +1,206 @@
+// QTNMTelemetry
+//
+//----------------------------------------------------------------------------
+//
+
+#include "QTNMTelemetry.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "G4Threading.hh"
+#include "G4ios.hh"
+
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  // one cache line per thread, index thread ID + 1 (master or sequential 0)
+  const G4int kMaxThreads = 512;
+  struct alignas(64) ThreadCount
+  {
+    std::atomic<G4long> events{ 0 };
+    std::atomic<G4long> last{ 0 };    // clock ticks at its latest event
+  };
+  ThreadCount threadCounts[kMaxThreads];
+
+  std::atomic<G4long> eventsDone{ 0 };
+  std::atomic<G4long> nextReport{ 0 };   // clock ticks
+  G4long              eventsTotal = 0;
+  G4double            interval    = 10.;  // seconds
+  Clock::time_point   runStart;
+
+  // last report, written only by the reporting thread
+  G4long              lastEvents = 0;
+  Clock::time_point   lastTime;
+
+  QTNMTelemetry::Summary lastRun;
+
+  G4double Seconds(Clock::duration d)
+  {
+    return std::chrono::duration<G4double>(d).count();
+  }
+
+  G4long Ticks(G4double seconds)
+  {
+    return std::chrono::duration_cast<Clock::duration>(
+             std::chrono::duration<G4double>(seconds)).count();
+  }
+
+  // event counts of the least and most loaded threads that took part
+  void Balance(G4long& least, G4long& most, G4int& threads)
+  {
+    least   = -1;
+    most    = 0;
+    threads = 0;
+    for(const auto& count : threadCounts)
+    {
+      G4long n = count.events.load(std::memory_order_relaxed);
+      if(n == 0) continue;
+      least = (least < 0) ? n : std::min(least, n);
+      most  = std::max(most, n);
+      ++threads;
+    }
+    if(least < 0) least = 0;
+  }
+}
+
+void QTNMTelemetry::BeginOfRun(G4long nEvents)
+{
+  for(auto& count : threadCounts)
+  {
+    count.events.store(0);
+    count.last.store(0);
+  }
+  eventsDone.store(0);
+  eventsTotal = nEvents;
+  runStart    = Clock::now();
+  lastTime    = runStart;
+  lastEvents  = 0;
+  nextReport.store((interval > 0.) ? (runStart.time_since_epoch().count() + Ticks(interval))
+                                   : -1);
+}
+
+void QTNMTelemetry::EndOfEvent()
+{
+  G4int slot = std::min(std::max(G4Threading::G4GetThreadId() + 1, 0), kMaxThreads - 1);
+  auto   now  = Clock::now();
+  G4long tick = now.time_since_epoch().count();
+  threadCounts[slot].events.fetch_add(1, std::memory_order_relaxed);
+  threadCounts[slot].last.store(tick, std::memory_order_relaxed);
+  G4long done = eventsDone.fetch_add(1, std::memory_order_relaxed) + 1;
+
+  // one thread claims the report
+  G4long due = nextReport.load(std::memory_order_relaxed);
+  if(due < 0) return;
+  if(tick < due) return;
+  if(!nextReport.compare_exchange_strong(due, tick + Ticks(interval))) return;
+
+  G4double elapsed = Seconds(now - runStart);
+  G4double rate    = (elapsed > 0.) ? done / elapsed : 0.;
+  G4double recent  = Seconds(now - lastTime);
+  G4double current = (recent > 0.) ? (done - lastEvents) / recent : 0.;
+  lastEvents = done;
+  lastTime   = now;
+
+  G4long least, most;
+  G4int  threads;
+  Balance(least, most, threads);
+
+  G4cout << ">>> Progress: " << done;
+  if(eventsTotal > 0) G4cout << " / " << eventsTotal;
+  G4cout << " events, " << rate << " ev/s (now " << current << " ev/s)";
+  if(eventsTotal > 0 && rate > 0.)
+    G4cout << ", ETA " << (eventsTotal - done) / rate << " s";
+  G4cout << ", " << threads << " threads " << least << "-" << most << " events, peak RSS "
+         << PeakMemory() << " MB" << G4endl;
+}
+
+void QTNMTelemetry::EndOfRun(const G4String& summaryFile)
+{
+  Summary& run = lastRun;
+  run.wallTime = Seconds(Clock::now() - runStart);
+  run.events   = eventsDone.load();
+  run.rate     = (run.wallTime > 0.) ? run.events / run.wallTime : 0.;
+
+  G4long least, most;
+  Balance(least, most, run.threads);
+  G4double mean = (run.threads > 0) ? (G4double) run.events / run.threads : 0.;
+  run.imbalance = (mean > 0.) ? most / mean : 1.;
+
+  // seconds into the run each thread finished its last event; the spread
+  // is the time threads stood idle waiting for the slowest
+  run.threadEvents.clear();
+  run.threadFinish.clear();
+  for(const auto& count : threadCounts)
+  {
+    G4long n = count.events.load();
+    if(n == 0) continue;
+    run.threadEvents.push_back(n);
+    run.threadFinish.push_back(Seconds(Clock::duration(count.last.load()) - runStart.time_since_epoch()));
+  }
+  const auto& finish = run.threadFinish;
+  run.tail = finish.empty() ? 0.
+    : *std::max_element(finish.begin(), finish.end()) - *std::min_element(finish.begin(), finish.end());
+  run.peakRSS = PeakMemory();
+
+  G4cout << ">>> Run: " << run.events << " events in " << run.wallTime << " s, " << run.rate
+         << " ev/s, thread events max/mean " << run.imbalance << ", last threads idle for "
+         << run.tail << " s, peak RSS " << run.peakRSS << " MB" << G4endl;
+
+  if(summaryFile.empty() || summaryFile == "none") return;
+
+  std::ofstream out(summaryFile);
+  if(!out)
+  {
+    G4ExceptionDescription msg;
+    msg << "Cannot write run summary " << summaryFile << ".";
+    G4Exception("QTNMTelemetry::EndOfRun()", "QTNM0007", JustWarning, msg);
+    return;
+  }
+  out << "{\n";
+  WriteJSON(out, run);
+  out << "\n}\n";
+}
+
+void QTNMTelemetry::WriteJSON(std::ostream& out, const Summary& run)
+{
+  out << "  \"events\": " << run.events << ",\n"
+      << "  \"wall_time_s\": " << run.wallTime << ",\n"
+      << "  \"events_per_s\": " << run.rate << ",\n"
+      << "  \"threads\": " << run.threads << ",\n"
+      << "  \"thread_events\": [";
+  for(std::size_t i = 0; i < run.threadEvents.size(); ++i)
+    out << (i ? ", " : "") << run.threadEvents[i];
+  out << "],\n"
+      << "  \"thread_finish_s\": [";
+  for(std::size_t i = 0; i < run.threadFinish.size(); ++i)
+    out << (i ? ", " : "") << run.threadFinish[i];
+  out << "],\n"
+      << "  \"imbalance\": " << run.imbalance << ",\n"
+      << "  \"tail_s\": " << run.tail << ",\n"
+      << "  \"peak_rss_mb\": " << run.peakRSS;
+}
+
+void QTNMTelemetry::SetInterval(G4double seconds)
+{
+  interval = seconds;
+}
+
+G4double QTNMTelemetry::PeakMemory()
+{
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) != 0) return 0.;
+  return usage.ru_maxrss / 1024.;  // kB on Linux
+}
+
+const QTNMTelemetry::Summary& QTNMTelemetry::LastRun()
+{
+  return lastRun;
+}
@@ -0,0 +1,71 @@
+// ********************************************************************
+// phase-space comparison
+//
+// Compares the records of a reference phase-space file with those of
+// one or more files holding the same events, e.g. the jobs of a split
+// production. Records are sorted by event ID and content first, so the
+// order in which threads wrote them does not matter. Exits with 1 if
+// the record counts or any record differ.
+// Usage: phaseSpaceCompare <reference> <file> [file ...]
+
+// standard
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+#include <vector>
+
+// Geant4
+#include "G4ios.hh"
+
+// us
+#include "QTNMPhaseSpace.hh"
+
+namespace
+{
+  std::vector<QTNMPhaseSpaceRecord> Read(int n, char** names)
+  {
+    std::vector<QTNMPhaseSpaceRecord> records;
+    for(int i = 0; i < n; ++i)
+    {
+      QTNMPhaseSpaceReader reader(names[i]);
+      for(std::size_t k = 0; k < reader.GetEntries(); ++k)
+        records.push_back(reader.GetRecord(k));
+    }
+
+    auto key = [](const QTNMPhaseSpaceRecord& r) {
+      return std::make_tuple(r.eventID, r.pdg, r.kine, r.dir[0], r.dir[1], r.dir[2],
+                             r.pos[0], r.pos[1], r.pos[2]);
+    };
+    std::sort(records.begin(), records.end(),
+              [&key](const QTNMPhaseSpaceRecord& a, const QTNMPhaseSpaceRecord& b) {
+                return key(a) < key(b);
+              });
+    return records;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  if(argc < 3)
+  {
+    G4cout << "Usage: phaseSpaceCompare <reference> <file> [file ...]" << G4endl;
+    return 1;
+  }
+
+  auto reference = Read(1, argv + 1);
+  auto parts     = Read(argc - 2, argv + 2);
+
+  G4cout << "Reference: " << reference.size() << " records, parts: "
+         << parts.size() << " records" << G4endl;
+  if(reference.size() != parts.size()) return 1;
+
+  for(std::size_t i = 0; i < reference.size(); ++i)
+  {
+    if(std::memcmp(&reference[i], &parts[i], sizeof(QTNMPhaseSpaceRecord)) != 0)
+    {
+      G4cout << "Records differ in event " << reference[i].eventID << G4endl;
+      return 1;
+    }
+  }
+  return reference.empty() ? 1 : 0;  // no scored particle checks nothing
+}
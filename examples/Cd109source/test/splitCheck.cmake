@@ -0,0 +1,30 @@
+# One run against the same events split into two jobs
+#
+# cmake -DAPP=<cd109source> -DCOMPARE=<phaseSpaceCompare> -DDIR=<test dir>
+#       -P splitCheck.cmake
+# Runs 200 events with two threads, then events 0-99 and 100-199 as
+# separate single-threaded jobs with --first-event, all with the same
+# seed, and fails unless the phase-space records, i.e. the scored
+# particles of every event, are identical.
+
+# name:first event:events:threads
+foreach(job full:0:200:2 first:0:100:1 second:100:100:1)
+  string(REPLACE ":" ";" job ${job})
+  list(GET job 0 name)
+  list(GET job 1 first)
+  list(GET job 2 n)
+  list(GET job 3 threads)
+  execute_process(COMMAND ${CMAKE_COMMAND} -E env PHSP=split-${name}.phsp
+                          ${APP} -s 3 -t ${threads} --first-event ${first} --n-events ${n}
+                          -o split-${name}.root -m ${DIR}/split.mac
+                  RESULT_VARIABLE status)
+  if(NOT status EQUAL 0)
+    message(FATAL_ERROR "${name} run failed (${status})")
+  endif()
+endforeach()
+
+execute_process(COMMAND ${COMPARE} split-full.phsp split-first.phsp split-second.phsp
+                RESULT_VARIABLE status)
+if(NOT status EQUAL 0)
+  message(FATAL_ERROR "split runs differ from the single run")
+endif()
@@ -26,49 +26,60 @@
 #include "CLI11.hpp"  // c++17 safe; https://github.com/CLIUtils/CLI11
 #include "EGActionInitialization.hh"
 #include "EGDetectorConstruction.hh"
+#include "QTNMBenchmark.hh"
+#include "QTNMEventSeeding.hh"
+#include "QTNMRunManager.hh"
+#include "QTNMStepMonitor.hh"
 
 int main(int argc, char** argv)
 {
   // command line interface
   CLI::App    app{ "Scattering example for QTNM" };
-  int         nthreads = 4;
-  int         seed     = 1234;
   std::string outputFileName("qtnm.root");
   std::string macroName;
+  int         monitor  = 0;
 
   app.add_option("-m,--macro", macroName, "<Geant4 macro filename> Default: None");
-  app.add_option("-s,--seed", seed, "<Geant4 random number seed + offset 1234> Default: 1234");
   app.add_option("-o,--outputFile", outputFileName,
                  "<FULL PATH ROOT FILENAME> Default: qtnm.root");
-  app.add_option("-t, --nthreads", nthreads, "<number of threads to use> Default: 4");
+  QTNMRunManager runOptions;  // run manager type, threads and event batching
+  runOptions.AddOptions(app);
+  QTNMEventSeeding seeding;   // seed and event range of this process
+  seeding.AddOptions(app);
+  QTNMBenchmark benchmark;    // reference workloads instead of a macro
+  benchmark.workloads = {
+    { "gas", "default gas cell, Gaussian 18.575 keV electron gun",
+      {},
+      { "/run/verbose 0", "/tracking/verbose 0" },
+      20, 200 } };
+  benchmark.AddOptions(app);
+  app.add_option("--monitor", monitor,
+                 "<n> Step statistics per process and volume, timing 1 in n steps. Default: 0, off");
 
   CLI11_PARSE(app, argc, argv);
 
+  // optional step statistics, set before the actions are built
+  QTNMStepMonitor::SetEnabled(monitor > 0);
+  QTNMStepMonitor::SetSampling(monitor);
+  benchmark.Prepare();  // counts steps unless monitored anyway
+
   // GEANT4 code
   // Get the pointer to the User Interface manager
   //
   G4UImanager* UImanager = G4UImanager::GetUIpointer();
 
   // Don't accept interactive mode (no macroName).
-  if(macroName.empty())
+  if(macroName.empty() && !benchmark.IsRequested())
   {
     G4cout << "No interactive mode running of example: provide a macro!" << G4endl;
     return 1;
   }
 
-  // set the random seed + offset 1234; avoiding zero seed -> runtime error
-  CLHEP::HepRandom::setTheSeed(1234+seed);
+  // seed from the command line, per event from (seed, run, global event ID)
+  seeding.Apply();
 
-  // -- Construct the run manager : MT or sequential one
-  auto* runManager = G4RunManagerFactory::CreateRunManager();
-#ifdef G4MULTITHREADED
-  nthreads =
-    std::min(nthreads, G4Threading::G4GetNumberOfCores());  // limit thread number to
-                                                            // max on machine
-  G4cout << "      ********* Run Manager constructed in MT mode: " << nthreads
-         << " threads ***** " << G4endl;
-  runManager->SetNumberOfThreads(nthreads);
-#endif
+  // -- Construct the run manager : serial, MT or tasking
+  auto* runManager = runOptions.Create();
 
 
   // -- Set mandatory initialization classes
@@ -90,13 +101,25 @@ int main(int argc, char** argv)
 
 
   // -- Set user action initialization class.
-  auto* actions = new EGActionInitialization(outputFileName);
+  auto* actions = new EGActionInitialization(outputFileName, seeding.Seed());
   runManager->SetUserInitialization(actions);
 
 
+  // reference workload instead of the macro
+  if(benchmark.IsRequested())
+  {
+    int status = benchmark.Run(seeding.Seed());
+    delete runManager;
+    return status;
+  }
+
   // Batch mode only - no visualisation
   G4String command = "/control/execute ";
   UImanager->ApplyCommand(command + macroName);
+
+  // a range of a split production, the macro only configures
+  if(seeding.nEvents > 0)
+    UImanager->ApplyCommand("/run/beamOn " + std::to_string(seeding.nEvents));
   
   delete runManager;
   return 0;
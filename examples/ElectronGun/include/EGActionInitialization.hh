@@ -9,7 +9,7 @@
 class EGActionInitialization : public G4VUserActionInitialization
 {
 public:
-  EGActionInitialization(G4String name);
+  EGActionInitialization(G4String name, G4long seed);
   virtual ~EGActionInitialization();
 
   virtual void BuildForMaster() const;
@@ -17,6 +17,7 @@ public:
 
 private:
   G4String foutname;
+  G4long   fSeed;  // primary pool seed
 };
 
 #endif
@@ -5,27 +5,47 @@
 #include "G4GenericMessenger.hh"
 #include "Randomize.hh"
 #include "globals.hh"
+#include "QTNMBetaSpectrum.hh"
+#include "QTNMPrimaryPool.hh"
+
+#include <vector>
 
 class G4ParticleGun;
 class G4Event;
+class QTNMPhaseSpaceReader;
 
 
 /// Primary generator
 ///
 /// A single particle is generated.
 /// macro commands can change primary properties.
+/// The source position depends on the world size, looked up
+/// once per run with UpdateGeometry().
+/// Energies and spot positions are sampled for a block of events
+/// at a time, reproducible for a given seed, see QTNMPrimaryPool.
+/// With /EG/generator/spectrum beta the energy follows the tritium
+/// beta spectrum instead of the gun Gaussian, optionally restricted to
+/// a window below the endpoint, see QTNMBetaSpectrum.
+/// With /EG/generator/phaseSpace the primaries are read from a phase-space
+/// file written by a source simulation instead, record i for event i, so
+/// each thread reads the records of its own events.
 
 class EGPrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
 public:
-  EGPrimaryGeneratorAction();
+  EGPrimaryGeneratorAction(G4long seed = 0);
   virtual ~EGPrimaryGeneratorAction();
 
   virtual void GeneratePrimaries(G4Event*);
 
+  // refresh geometry-derived source parameters, at run start
+  void UpdateGeometry();
+
 private:
 
   void DefineCommands();
+  void SetPoolSize(G4int size);
+  void GeneratePhaseSpace(G4Event* event);
 
   G4ParticleGun*      fParticleGun;
   G4GenericMessenger* fMessenger;
@@ -34,6 +54,29 @@ private:
   G4double            fStdev;
   G4double            fSpot;
 
+  // energy spectrum, gun Gaussian or tritium beta decay
+  G4String            fSpectrum  = "gauss";
+  G4double            fEndpoint  = 18.575;  // [keV]
+  G4double            fWindowMin = 0.;      // [keV]
+  G4double            fWindowMax = 0.;      // [keV], 0 for the endpoint
+  QTNMBetaSpectrum    fBeta;
+
+  G4double            fSourceZ       = 0.;
+  G4bool              fGeometryValid = false;
+
+  // pre-sampled primaries
+  G4long                fSeed;
+  QTNMPrimaryPool       fPool;
+
+  // phase-space input
+  G4String              fPhaseSpace    = "none";
+  G4int                 fPDG           = 0;      // 0 for all particles
+  G4bool                fKeepPosition  = false;
+  QTNMPhaseSpaceReader* fReader        = nullptr;
+  G4int                 fReaderPDG     = 0;
+  G4ParticleGun*        fPhaseSpaceGun = nullptr;  // keeps the gun settings for phaseSpace none
+  G4bool                fRecycled      = false;
+
 };
 
 #endif
@@ -4,6 +4,7 @@
 #include "G4UserRunAction.hh"
 #include "globals.hh"
 
+class EGPrimaryGeneratorAction;
 class G4Run;
 
 /// Run action class
@@ -12,7 +13,7 @@ class G4Run;
 class EGRunAction : public G4UserRunAction
 {
 public:
-  EGRunAction(G4String name);
+  EGRunAction(G4String name, EGPrimaryGeneratorAction* primary = nullptr);
   virtual ~EGRunAction();
 
   virtual void BeginOfRunAction(const G4Run*);
@@ -20,6 +21,7 @@ public:
 
 private:
   G4String         fout;          // output file name
+  EGPrimaryGeneratorAction* fPrimary;  // worker threads only
 };
 
 
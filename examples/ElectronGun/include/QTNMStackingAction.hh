@@ -0,0 +1,78 @@
+// QTNMStackingAction
+//
+//----------------------------------------------------------------------------
+//
+// Stacking action with macro rules to discard secondaries that cannot
+// contribute to the scored output.
+//
+// Rules are checked in the order they were given, the first one matching
+// a new secondary decides:
+//
+//   kill <pdg>                       kill all of this particle type
+//   killBelow <pdg> <E> <unit>       kill below a kinetic energy, pdg 0: any
+//   killInVolume <volume> [pdg]      kill if created in this logical volume
+//   postpone <pdg>                   move to the waiting stack, tracked
+//                                    once the urgent stack is empty
+//   clear                            remove all rules
+//
+// Primaries are never touched. Every thread counts the tracks and kinetic
+// energy each rule removed or postponed, reported apart since postponed
+// tracks are still tracked; the run action calls Flush() on all threads
+// and Report() on the master at the end of a run, so a rule's effect on
+// the results can be checked. Applications derive from this class for
+// their own classification and fall back to it.
+//
+
+#ifndef QTNMStackingAction_h
+#define QTNMStackingAction_h 1
+
+#include "G4GenericMessenger.hh"
+#include "G4UserStackingAction.hh"
+#include "globals.hh"
+
+#include <vector>
+
+
+class QTNMStackingAction : public G4UserStackingAction
+{
+public:
+
+  QTNMStackingAction(const G4String& commandDir);
+  virtual ~QTNMStackingAction();
+
+  virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track);
+
+  // add this thread's counts to the run totals
+  static void Flush();
+
+  // print and reset the run totals, master only
+  static void Report();
+
+private:
+  struct Rule
+  {
+    G4ClassificationOfNewTrack action  = fKill;
+    G4int                      pdg     = 0;   // 0: any particle
+    G4double                   below   = 0.;  // kinetic energy, 0: any
+    G4String                   volume;        // creator volume, empty: any
+    G4String                   name;          // as given, for the report
+    G4int                      tracks  = 0;
+    G4double                   energy  = 0.;
+  };
+
+  void AddRule(Rule rule);
+
+  void Kill(G4int pdg);
+  void KillBelow(const G4String& args);
+  void KillInVolume(const G4String& args);
+  void Postpone(G4int pdg);
+  void Clear();
+
+  void DefineCommands(const G4String& commandDir);
+
+  G4GenericMessenger* fMessenger = nullptr;
+  std::vector<Rule>   fRules;
+};
+
+
+#endif
@@ -2,11 +2,14 @@
 #include "EGEventAction.hh"
 #include "EGPrimaryGeneratorAction.hh"
 #include "EGRunAction.hh"
+#include "QTNMStackingAction.hh"
+#include "QTNMStepMonitor.hh"
 
 
-EGActionInitialization::EGActionInitialization(G4String name)
+EGActionInitialization::EGActionInitialization(G4String name, G4long seed)
 : G4VUserActionInitialization()
 , foutname(std::move(name))
+, fSeed(seed)
 {}
 
 EGActionInitialization::~EGActionInitialization() = default;
@@ -19,8 +22,11 @@ void EGActionInitialization::BuildForMaster() const
 void EGActionInitialization::Build() const
 {
   // forward detector
-  SetUserAction(new EGPrimaryGeneratorAction());
+  auto primary = new EGPrimaryGeneratorAction(fSeed);
+  SetUserAction(primary);
   auto event = new EGEventAction;
   SetUserAction(event);
-  SetUserAction(new EGRunAction(foutname));
+  SetUserAction(new EGRunAction(foutname, primary));
+  SetUserAction(new QTNMStackingAction("/EG/stack/"));
+  if(QTNMStepMonitor::IsEnabled()) SetUserAction(new QTNMStepMonitor);
 }
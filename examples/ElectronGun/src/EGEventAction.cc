@@ -1,4 +1,6 @@
 #include "EGEventAction.hh"
+#include "QTNMEventSeeding.hh"
+#include "QTNMTelemetry.hh"
 #include "g4root.hh"
 
 #include <vector>
@@ -36,6 +38,9 @@ void EGEventAction::BeginOfEventAction(const G4Event*
 
 void EGEventAction::EndOfEventAction(const G4Event* event)
 {
+  // progress, instead of printing every event
+  QTNMTelemetry::EndOfEvent();
+
   // Get GAS hits collections IDs
   if(fGID < 0) 
     fGID = G4SDManager::GetSDMpointer()->GetCollectionID("GasHitsCollection");
@@ -86,7 +91,7 @@ void EGEventAction::EndOfEventAction(const G4Event* event)
   }
 
   // fill the ntuple - check column id?
-  G4int eventID = event->GetEventID();
+  G4int eventID = (G4int) QTNMEventSeeding::EventID(event);
   for (unsigned int i=0;i<tedep.size();i++)
   {
     analysisManager->FillNtupleIColumn(0, eventID); // repeat all rows
@@ -1,8 +1,12 @@
 // us
 #include "EGPrimaryGeneratorAction.hh"
+#include "QTNMEventSeeding.hh"
+#include "QTNMPhaseSpace.hh"
 
 // geant
 #include "G4Event.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
 #include "G4ThreeVector.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4ParticleGun.hh"
@@ -12,16 +16,17 @@
 #include "G4LogicalVolumeStore.hh"
 #include "G4LogicalVolume.hh"
 #include "G4Box.hh"
-#include "G4RandomTools.hh"
 
 
-EGPrimaryGeneratorAction::EGPrimaryGeneratorAction()
+EGPrimaryGeneratorAction::EGPrimaryGeneratorAction(G4long seed)
 : G4VUserPrimaryGeneratorAction()
 , fParticleGun(nullptr)
 , fMessenger(nullptr)
 , fMean(18.575)
 , fStdev(5.e-4)
 , fSpot(0.5)
+, fSeed(seed)
+, fPool(4, 3)  // energy and spot, two uniforms each; energy, x, y
 {
   G4int nofParticles = 1;
   fParticleGun       = new G4ParticleGun(nofParticles);
@@ -37,31 +42,136 @@ EGPrimaryGeneratorAction::EGPrimaryGeneratorAction()
 
 EGPrimaryGeneratorAction::~EGPrimaryGeneratorAction()
 {
+  delete fReader;
+  delete fPhaseSpaceGun;
   delete fMessenger;
   delete fParticleGun;
 }
 
-void EGPrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
+void EGPrimaryGeneratorAction::UpdateGeometry()
 {
   // In order to avoid dependence of PrimaryGeneratorAction
   // on DetectorConstruction class we get world volume 
   // from G4LogicalVolumeStore: assumes name is World_log!
   //
   auto worldLV = G4LogicalVolumeStore::GetInstance()->GetVolume("World_log");
-  G4Box* worldBox = dynamic_cast<G4Box*>(worldLV->GetSolid());
-  G4double worldZHalfLength = worldBox->GetZHalfLength();
-
-  // random spot location [mm]
-  G4TwoVector loc = G4RandomPointInEllipse(fSpot/2.0, fSpot/2.0); // circle
-  fParticleGun->SetParticlePosition(G4ThreeVector(loc.x()*mm, loc.y()*mm, -worldZHalfLength + 1.*cm));
+  G4Box* worldBox = worldLV ? dynamic_cast<G4Box*>(worldLV->GetSolid()) : nullptr;
+  if(!worldBox)
+  {
+    G4Exception("EGPrimaryGeneratorAction::UpdateGeometry()", "EG0001",
+                FatalException, "World_log box volume not found.");
+    return;
+  }
+  fSourceZ       = -worldBox->GetZHalfLength() + 1.*cm;
+  fGeometryValid = true;
+}
 
-  // Gaussian random energy [keV]
-  G4double en = G4RandGauss::shoot(fMean, fStdev);
-  fParticleGun->SetParticleEnergy(en * keV);
+void EGPrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
+{
+  // random numbers of this event independent of thread and job
+  QTNMEventSeeding::SeedEvent(event);
+
+  // geometry only changes between runs
+  if(!fGeometryValid) UpdateGeometry();
+
+  if(fPhaseSpace != "none")
+  {
+    GeneratePhaseSpace(event);
+    return;
+  }
+
+  // pool block of this event, sampled once by the first thread to need it
+  G4long eventID = QTNMEventSeeding::EventID(event);
+  auto   runManager = G4RunManager::GetRunManager();
+  G4int  runID = (runManager && runManager->GetCurrentRun())
+                 ? runManager->GetCurrentRun()->GetRunID() : 0;
+  fPool.Fill(fSeed, runID, eventID, [this]()
+  {
+    G4int n = fPool.GetSize();
+    // Gaussian or beta random energy [keV], random spot location [mm]
+    if(fSpectrum == "beta")
+    {
+      fBeta.Configure(fEndpoint * keV, fWindowMin * keV, fWindowMax * keV);
+      const G4double* u1 = fPool.Uniforms(0);
+      const G4double* u2 = fPool.Uniforms(1);
+      G4double* energy   = fPool.Outputs(0);
+      for(G4int k = 0; k < n; ++k) energy[k] = fBeta.Sample(u1[k], u2[k]) / keV;
+    }
+    else
+      QTNMPrimaryPool::Gauss(n, fPool.Uniforms(0), fPool.Uniforms(1), fMean, fStdev, fPool.Outputs(0));
+    QTNMPrimaryPool::Disk(n, fPool.Uniforms(2), fPool.Uniforms(3), fSpot/2.0, fPool.Outputs(1), fPool.Outputs(2));
+  });
+
+  fParticleGun->SetParticlePosition(G4ThreeVector(fPool.Output(1, eventID)*mm,
+                                                  fPool.Output(2, eventID)*mm, fSourceZ));
+  fParticleGun->SetParticleEnergy(fPool.Output(0, eventID) * keV);
 
   fParticleGun->GeneratePrimaryVertex(event);
 }
 
+void EGPrimaryGeneratorAction::GeneratePhaseSpace(G4Event* event)
+{
+  // (re)map on a new file name, the mapping is kept across runs
+  if(!fReader || fReader->GetName() != fPhaseSpace)
+  {
+    delete fReader;
+    fReader    = new QTNMPhaseSpaceReader(fPhaseSpace);
+    fReaderPDG = 0;
+    fRecycled  = false;
+  }
+  if(fReaderPDG != fPDG)
+  {
+    fReader->SetPDG(fPDG);
+    fReaderPDG = fPDG;
+  }
+
+  std::size_t nRecords = fReader->GetEntries();
+  if(nRecords == 0)
+  {
+    G4ExceptionDescription msg;
+    msg << "No selected records in phase-space file " << fPhaseSpace << ".";
+    G4Exception("EGPrimaryGeneratorAction::GeneratePhaseSpace()", "EG0002",
+                FatalException, msg);
+    return;
+  }
+
+  std::size_t index = QTNMEventSeeding::EventID(event);
+  if(index >= nRecords && !fRecycled)
+  {
+    G4ExceptionDescription msg;
+    msg << "More events than the " << nRecords << " selected records in "
+        << fPhaseSpace << ", records are reused.";
+    G4Exception("EGPrimaryGeneratorAction::GeneratePhaseSpace()", "EG0002",
+                JustWarning, msg);
+    fRecycled = true;
+  }
+  const auto& record = fReader->GetRecord(index % nRecords);
+
+  auto particle = G4ParticleTable::GetParticleTable()->FindParticle(record.pdg);
+  if(!particle)
+  {
+    G4ExceptionDescription msg;
+    msg << "Unknown PDG code " << record.pdg << " in " << fPhaseSpace << ".";
+    G4Exception("EGPrimaryGeneratorAction::GeneratePhaseSpace()", "EG0002",
+                FatalException, msg);
+    return;
+  }
+
+  // records in internal units, placed relative to the source position
+  G4ThreeVector position(0., 0., fSourceZ);
+  if(fKeepPosition)
+    position += G4ThreeVector(record.pos[0], record.pos[1], record.pos[2]);
+
+  // own gun, the macro settings of the main gun stay for later runs
+  if(!fPhaseSpaceGun) fPhaseSpaceGun = new G4ParticleGun(1);
+  fPhaseSpaceGun->SetParticleDefinition(particle);
+  fPhaseSpaceGun->SetParticleEnergy(record.kine);
+  fPhaseSpaceGun->SetParticleMomentumDirection(
+    G4ThreeVector(record.dir[0], record.dir[1], record.dir[2]));
+  fPhaseSpaceGun->SetParticlePosition(position);
+  fPhaseSpaceGun->GeneratePrimaryVertex(event);
+}
+
 
 void EGPrimaryGeneratorAction::DefineCommands()
 {
@@ -89,4 +199,54 @@ void EGPrimaryGeneratorAction::DefineCommands()
   spotCmd.SetParameterName("s", true);
   spotCmd.SetRange("s>=0.");
   spotCmd.SetDefaultValue("0.5");
+
+  // spectrum commands
+  fMessenger->DeclareProperty("spectrum", fSpectrum,
+                              "Energy spectrum: gauss, the gun energy and width, or beta for tritium decay.")
+    .SetCandidates("gauss beta");
+
+  auto& endCmd = fMessenger->DeclareProperty("endpoint", fEndpoint,
+                                             "Beta spectrum endpoint [keV].");
+  endCmd.SetParameterName("q", true);
+  endCmd.SetRange("q>0.");
+  endCmd.SetDefaultValue("18.575");
+
+  auto& minCmd = fMessenger->DeclareProperty("windowMin", fWindowMin,
+                                             "Lowest sampled beta energy [keV].");
+  minCmd.SetParameterName("e", true);
+  minCmd.SetRange("e>=0.");
+  minCmd.SetDefaultValue("0.");
+
+  auto& maxCmd = fMessenger->DeclareProperty("windowMax", fWindowMax,
+                                             "Highest sampled beta energy [keV], 0 for the endpoint.");
+  maxCmd.SetParameterName("e", true);
+  maxCmd.SetRange("e>=0.");
+  maxCmd.SetDefaultValue("0.");
+
+  // pool size command
+  fMessenger->DeclareMethod("poolSize", &EGPrimaryGeneratorAction::SetPoolSize)
+    .SetGuidance("Number of primaries sampled at a time.")
+    .SetGuidance("Changes the primaries for a given seed.")
+    .SetParameterName("n", false)
+    .SetRange("n>0");
+
+  // phase-space input
+  fMessenger->DeclareProperty("phaseSpace", fPhaseSpace,
+                              "Read primaries from this phase-space file, none for the gun.");
+
+  auto& pdgCmd = fMessenger->DeclareProperty("pdg", fPDG,
+                                             "Use phase-space records of this PDG code only, 0 for all.");
+  pdgCmd.SetParameterName("code", true);
+  pdgCmd.SetDefaultValue("0");
+
+  auto& posCmd = fMessenger->DeclareProperty("keepPosition", fKeepPosition,
+                                             "Offset phase-space primaries by their recorded position.");
+  posCmd.SetGuidance("Otherwise all start at the source position.");
+  posCmd.SetParameterName("flag", true);
+  posCmd.SetDefaultValue("true");
+}
+
+void EGPrimaryGeneratorAction::SetPoolSize(G4int size)
+{
+  fPool.SetSize(size);
 }
@@ -1,4 +1,8 @@
 #include "EGRunAction.hh"
+#include "EGPrimaryGeneratorAction.hh"
+#include "QTNMStackingAction.hh"
+#include "QTNMStepMonitor.hh"
+#include "QTNMTelemetry.hh"
 #include "g4root.hh"
 
 #include "G4Run.hh"
@@ -6,9 +10,10 @@
 #include "G4SystemOfUnits.hh"
 #include "G4UnitsTable.hh"
 
-EGRunAction::EGRunAction(G4String name)
+EGRunAction::EGRunAction(G4String name, EGPrimaryGeneratorAction* primary)
 : G4UserRunAction()
 , fout(std::move(name))
+, fPrimary(primary)
 {
   // Create analysis manager
   auto analysisManager = G4AnalysisManager::Instance();
@@ -36,8 +41,14 @@ EGRunAction::EGRunAction(G4String name)
 
 EGRunAction::~EGRunAction() { delete G4AnalysisManager::Instance(); }
 
-void EGRunAction::BeginOfRunAction(const G4Run* /*run*/)
+void EGRunAction::BeginOfRunAction(const G4Run* run)
 {
+  // progress and throughput, workers only count events
+  if(IsMaster()) QTNMTelemetry::BeginOfRun(run->GetNumberOfEventToBeProcessed());
+
+  // Geometry may have changed since the last run
+  if(fPrimary) fPrimary->UpdateGeometry();
+
   // Get analysis manager
   auto analysisManager = G4AnalysisManager::Instance();
 
@@ -55,4 +66,12 @@ void EGRunAction::EndOfRunAction(const G4Run* /*run*/)
   //
   analysisManager->Write();
   analysisManager->CloseFile();
+
+  // stacking rule counts and step statistics, workers end their runs first
+  QTNMStackingAction::Flush();
+  if(IsMaster()) QTNMStackingAction::Report();
+  QTNMStepMonitor::Flush();
+  if(IsMaster()) QTNMStepMonitor::Report();
+
+  if(IsMaster()) QTNMTelemetry::EndOfRun("none");
 }
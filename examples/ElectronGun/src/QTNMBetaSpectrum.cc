@@ -0,0 +1,116 @@
+// QTNMBetaSpectrum
+//
+//----------------------------------------------------------------------------
+//
+
+#include "QTNMBetaSpectrum.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+
+
+namespace
+{
+  const G4int kDaughterZ = 2;   // He-3
+}
+
+QTNMBetaSpectrum::QTNMBetaSpectrum(G4int nBins)
+  : fBins(std::max(nBins, 1))
+{}
+
+G4bool QTNMBetaSpectrum::Configure(G4double endpoint, G4double emin, G4double emax)
+{
+  if(emax <= 0. || emax > endpoint) emax = endpoint;
+  emin = std::max(emin, 0.);
+  if(emin >= emax)
+  {
+    G4ExceptionDescription msg;
+    msg << "Empty beta spectrum window [" << emin / keV << ", " << emax / keV
+        << "] keV, using the full spectrum.";
+    G4Exception("QTNMBetaSpectrum::Configure()", "QTNM0004", JustWarning, msg);
+    emin = 0.;
+    emax = endpoint;
+  }
+  if(endpoint == fEndpoint && emin == fEmin && emax == fEmax) return false;
+
+  fEndpoint = endpoint;
+  fEmin     = emin;
+  fEmax     = emax;
+  Build();
+  return true;
+}
+
+G4double QTNMBetaSpectrum::Density(G4double e) const
+{
+  if(e <= 0. || e >= fEndpoint) return 0.;
+
+  G4double mass  = electron_mass_c2;
+  G4double total = e + mass;
+  G4double p     = std::sqrt(e * (e + 2. * mass));
+
+  // non-relativistic Fermi function
+  G4double eta   = fine_structure_const * kDaughterZ * total / p;
+  G4double fermi = twopi * eta / (1. - std::exp(-twopi * eta));
+
+  G4double nu = fEndpoint - e;
+  return fermi * p * total * nu * nu;
+}
+
+void QTNMBetaSpectrum::Build()
+{
+  // bin weights at the bin centres
+  fWidth = (fEmax - fEmin) / fBins;
+  std::vector<G4double> weight(fBins);
+  G4double sum = 0.;
+  for(G4int i = 0; i < fBins; ++i)
+  {
+    weight[i] = Density(fEmin + (i + 0.5) * fWidth);
+    sum += weight[i];
+  }
+
+  // fraction of all decays inside the window, same binning over [0, Q]
+  G4double fullWidth = fEndpoint / fBins;
+  G4double full      = 0.;
+  for(G4int i = 0; i < fBins; ++i) full += Density((i + 0.5) * fullWidth);
+  fFraction = (full > 0.) ? sum * fWidth / (full * fullWidth) : 0.;
+
+  // Walker alias table, Vose's construction
+  fProb.assign(fBins, 1.);
+  fAlias.resize(fBins);
+  std::vector<G4int> small, large;
+  for(G4int i = 0; i < fBins; ++i)
+  {
+    fAlias[i]  = i;
+    weight[i] *= (sum > 0.) ? fBins / sum : 1.;
+    (weight[i] < 1. ? small : large).push_back(i);
+  }
+  while(!small.empty() && !large.empty())
+  {
+    G4int s = small.back();
+    small.pop_back();
+    G4int l = large.back();
+    large.pop_back();
+
+    fProb[s]  = weight[s];
+    fAlias[s] = l;
+    weight[l] += weight[s] - 1.;
+    (weight[l] < 1. ? small : large).push_back(l);
+  }
+
+  G4cout << ">> Beta spectrum: endpoint " << fEndpoint / keV << " keV, window ["
+         << fEmin / keV << ", " << fEmax / keV << "] keV holds a fraction "
+         << fFraction << " of all decays." << G4endl;
+}
+
+G4double QTNMBetaSpectrum::Sample(G4double u1, G4double u2) const
+{
+  // bin from the integer part of u1 * n, alias test on its fraction
+  G4double x = u1 * fBins;
+  G4int    k = std::min((G4int) x, fBins - 1);
+  G4int    i = (x - k < fProb[k]) ? k : fAlias[k];
+  return fEmin + (i + u2) * fWidth;
+}
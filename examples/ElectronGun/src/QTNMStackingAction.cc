@@ -0,0 +1,199 @@
+// QTNMStackingAction
+//
+//----------------------------------------------------------------------------
+//
+
+#include "QTNMStackingAction.hh"
+
+#include <map>
+#include <sstream>
+
+#include "G4AutoLock.hh"
+#include "G4LogicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Threading.hh"
+#include "G4Track.hh"
+#include "G4UnitsTable.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4ios.hh"
+
+
+namespace
+{
+  struct Total
+  {
+    G4bool   postponed = false;  // still tracked, not removed
+    G4int    tracks    = 0;
+    G4double energy    = 0.;
+  };
+
+  // run totals by rule, filled by all threads
+  G4Mutex                    stackingMutex = G4MUTEX_INITIALIZER;
+  std::map<G4String, Total>  runTotals;
+
+  // this thread's stacking action, to flush from the run action
+  G4ThreadLocal QTNMStackingAction* threadInstance = nullptr;
+}
+
+QTNMStackingAction::QTNMStackingAction(const G4String& commandDir)
+  : G4UserStackingAction()
+{
+  threadInstance = this;
+  DefineCommands(commandDir);
+}
+
+QTNMStackingAction::~QTNMStackingAction()
+{
+  if(threadInstance == this) threadInstance = nullptr;
+  delete fMessenger;
+}
+
+G4ClassificationOfNewTrack QTNMStackingAction::ClassifyNewTrack(const G4Track* track)
+{
+  if(fRules.empty() || track->GetParentID() == 0) return fUrgent;
+
+  G4int    pdg  = track->GetDefinition()->GetPDGEncoding();
+  G4double kine = track->GetKineticEnergy();
+
+  for(auto& rule : fRules)
+  {
+    if(rule.pdg != 0 && rule.pdg != pdg) continue;
+    if(rule.below > 0. && kine >= rule.below) continue;
+    if(!rule.volume.empty())
+    {
+      auto volume = track->GetVolume();  // where the secondary was created
+      if(!volume || volume->GetLogicalVolume()->GetName() != rule.volume) continue;
+    }
+
+    rule.tracks += 1;
+    rule.energy += kine;
+    return rule.action;
+  }
+  return fUrgent;
+}
+
+void QTNMStackingAction::Flush()
+{
+  if(!threadInstance) return;
+
+  G4AutoLock lock(&stackingMutex);
+  for(auto& rule : threadInstance->fRules)
+  {
+    auto& total = runTotals[rule.name];
+    total.postponed = (rule.action == fWaiting);
+    total.tracks += rule.tracks;
+    total.energy += rule.energy;
+    rule.tracks = 0;
+    rule.energy = 0.;
+  }
+}
+
+void QTNMStackingAction::Report()
+{
+  G4AutoLock lock(&stackingMutex);
+  if(runTotals.empty()) return;
+
+  // removed and postponed tracks apart, postponed ones are still tracked
+  Total removed, postponed;
+  G4cout << ">>> Stacking rules:" << G4endl;
+  for(const auto& entry : runTotals)
+  {
+    const auto& total = entry.second;
+    G4cout << "    " << entry.first << ": " << total.tracks << " tracks, "
+           << G4BestUnit(total.energy, "Energy") << " kinetic energy "
+           << (total.postponed ? "postponed" : "removed") << G4endl;
+    auto& sum = total.postponed ? postponed : removed;
+    sum.tracks += total.tracks;
+    sum.energy += total.energy;
+  }
+  G4cout << "    removed: " << removed.tracks << " tracks, "
+         << G4BestUnit(removed.energy, "Energy") << "; postponed: " << postponed.tracks
+         << " tracks, " << G4BestUnit(postponed.energy, "Energy") << G4endl;
+  runTotals.clear();
+}
+
+void QTNMStackingAction::AddRule(Rule rule)
+{
+  fRules.push_back(std::move(rule));
+}
+
+void QTNMStackingAction::Kill(G4int pdg)
+{
+  Rule rule;
+  rule.pdg  = pdg;
+  rule.name = "kill " + std::to_string(pdg);
+  AddRule(rule);
+}
+
+void QTNMStackingAction::KillBelow(const G4String& args)
+{
+  // <pdg> <energy> <unit>
+  Rule        rule;
+  G4double    value = 0.;
+  G4String    unit;
+  std::istringstream is(args);
+  if(!(is >> rule.pdg >> value >> unit) || !G4UnitDefinition::IsUnitDefined(unit))
+  {
+    G4ExceptionDescription msg;
+    msg << "Expected <pdg> <energy> <unit>, got '" << args << "'.";
+    G4Exception("QTNMStackingAction::KillBelow()", "QTNM0006", JustWarning, msg);
+    return;
+  }
+  rule.below = value * G4UnitDefinition::GetValueOf(unit);
+  rule.name  = "killBelow " + args;
+  AddRule(rule);
+}
+
+void QTNMStackingAction::KillInVolume(const G4String& args)
+{
+  // <volume> [pdg]
+  Rule        rule;
+  std::istringstream is(args);
+  is >> rule.volume >> rule.pdg;
+  if(rule.volume.empty())
+  {
+    G4Exception("QTNMStackingAction::KillInVolume()", "QTNM0006", JustWarning,
+                "Expected <volume> [pdg].");
+    return;
+  }
+  rule.name = "killInVolume " + args;
+  AddRule(rule);
+}
+
+void QTNMStackingAction::Postpone(G4int pdg)
+{
+  Rule rule;
+  rule.action = fWaiting;
+  rule.pdg    = pdg;
+  rule.name   = "postpone " + std::to_string(pdg);
+  AddRule(rule);
+}
+
+void QTNMStackingAction::Clear()
+{
+  Flush();  // keep the counts of the rules removed
+  fRules.clear();
+}
+
+void QTNMStackingAction::DefineCommands(const G4String& commandDir)
+{
+  fMessenger = new G4GenericMessenger(this, commandDir, "Secondary stacking rules");
+
+  fMessenger->DeclareMethod("kill", &QTNMStackingAction::Kill,
+                            "Kill secondaries of this PDG code.")
+    .SetParameterName("pdg", false);
+
+  fMessenger->DeclareMethod("killBelow", &QTNMStackingAction::KillBelow,
+                            "Kill secondaries below a kinetic energy: <pdg> <energy> <unit>.")
+    .SetGuidance("PDG code 0 applies to all particles.");
+
+  fMessenger->DeclareMethod("killInVolume", &QTNMStackingAction::KillInVolume,
+                            "Kill secondaries created in a logical volume: <volume> [pdg].");
+
+  fMessenger->DeclareMethod("postpone", &QTNMStackingAction::Postpone,
+                            "Track secondaries of this PDG code after all others.")
+    .SetParameterName("pdg", false);
+
+  fMessenger->DeclareMethod("clear", &QTNMStackingAction::Clear,
+                            "Remove all stacking rules.");
+}
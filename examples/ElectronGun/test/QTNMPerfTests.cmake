@@ -0,0 +1,30 @@
+# QTNMPerfTests
+#
+# Performance tests of the --benchmark workloads of a QTNM application
+# (QTNMBenchmark); select with ctest -L perf, skip with ctest -LE perf.
+#
+#   qtnm_add_perf_tests(<executable> <workload>...)
+#
+# adds a test perf-<workload> per workload, writing its result to perf/ in
+# the test build directory and comparing it with the baseline of the same
+# name in PERF_BASELINE_DIR. Baselines hold the timings of one machine and
+# thread count, so the tests never record them: a test without a baseline
+# is skipped, and copying its result to PERF_BASELINE_DIR records one.
+
+set(PERF_BASELINE_DIR "${PROJECT_SOURCE_DIR}/test/perf-baselines" CACHE PATH
+  "Directory of the perf test baselines, tests without one are skipped")
+set(PERF_TOLERANCE 0.3 CACHE STRING "Allowed slow-down fraction of the perf tests")
+set(PERF_THREADS 1 CACHE STRING "Worker threads of the perf tests")
+
+function(qtnm_add_perf_tests executable)
+  file(MAKE_DIRECTORY "${CMAKE_CURRENT_BINARY_DIR}/perf")
+  foreach(workload ${ARGN})
+    add_test(NAME perf-${workload} COMMAND ${executable} --benchmark ${workload} -s 1 -t ${PERF_THREADS}
+      --benchmark-output "${CMAKE_CURRENT_BINARY_DIR}/perf/${workload}.json"
+      --benchmark-baseline "${PERF_BASELINE_DIR}/${workload}.json"
+      --benchmark-tolerance ${PERF_TOLERANCE})
+    # QTNMBenchmark::kSkipped
+    set_tests_properties(perf-${workload} PROPERTIES LABELS perf RUN_SERIAL TRUE
+      SKIP_RETURN_CODE 77)
+  endforeach()
+endfunction()
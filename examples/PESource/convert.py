@@ -15,13 +15,13 @@ def convert(fname):
     tree = ff.Get("Score")
     store = []
     for ev in tree:
-        row = (ev.EventID,ev.TrackID,ev.PDG,ev.Kine,ev.Px,ev.Py,ev.Pz,ev.Posx,ev.Posy,ev.Posz)
+        row = (ev.EventID,ev.TrackID,ev.PDG,ev.Kine,ev.Px,ev.Py,ev.Pz,ev.Posx,ev.Posy,ev.Posz,ev.Weight)
         store.append(row) # store in memory
     arr = np.array(store) # list of tuples into array table, all as type float
     ff.Close()
 
     # now persist on disk
-    np.savetxt(outfname+".csv.gz", arr, delimiter=',', header='evID, trackID, PDG, KE, Px, Py, Pz, posx, posy, posz')
+    np.savetxt(outfname+".csv.gz", arr, delimiter=',', header='evID, trackID, PDG, KE, Px, Py, Pz, posx, posy, posz, weight')
     print('stored array with dim: ',arr.shape)
 
 
@@ -8,7 +8,8 @@
 /// Gas hit class
 ///
 /// It defines data members to store the energy deposit,
-/// kinetic energy and momentum in a selected volume:
+/// kinetic energy and momentum in a selected volume, and the
+/// statistical weight of the track, not 1 with importance biasing:
 
 class PEGasHit : public G4VHit
 {
@@ -38,6 +39,7 @@ class PEGasHit : public G4VHit
     void SetPosx        (G4double lx)  { fPosx = lx; };
     void SetPosy        (G4double ly)  { fPosy = ly; };
     void SetPosz        (G4double lz)  { fPosz = lz; };
+    void SetWeight      (G4double w)   { fWeight = w; };
 
     // Get methods
     G4double GetTrackID() const     { return fTrackID; };
@@ -49,6 +51,7 @@ class PEGasHit : public G4VHit
     G4double GetPosx()    const     { return fPosx; };
     G4double GetPosy()    const     { return fPosy; };
     G4double GetPosz()    const     { return fPosz; };
+    G4double GetWeight()  const     { return fWeight; };
 
   private:
 
@@ -61,6 +64,7 @@ class PEGasHit : public G4VHit
       G4double      fPosx;
       G4double      fPosy;
       G4double      fPosz;
+      G4double      fWeight;
 };
 
 typedef G4THitsCollection<PEGasHit> PEGasHitsCollection;
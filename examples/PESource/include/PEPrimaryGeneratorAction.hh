@@ -4,6 +4,7 @@
 #include "G4VUserPrimaryGeneratorAction.hh"
 #include "G4GenericMessenger.hh"
 #include "globals.hh"
+#include "PEFastSource.hh"
 
 class G4GeneralParticleSource;
 class G4Event;
@@ -13,6 +14,9 @@ class G4Event;
 ///
 /// A single particle is generated.
 /// macro commands can change primary properties.
+/// With /PE/source/fast the GPS configuration is copied into a
+/// per-thread PEFastSource at the start of each run and sampled
+/// from there, see BeginOfRun().
 
 class PEPrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
@@ -22,9 +26,19 @@ public:
 
   virtual void GeneratePrimaries(G4Event*);
 
+  // snapshot the GPS configuration for the fast source, at run start
+  void BeginOfRun();
+
 private:
 
+  void DefineCommands();
+
   G4GeneralParticleSource*      fParticleGPS;
+  G4GenericMessenger*           fMessenger  = nullptr;
+
+  G4bool                        fUseFast    = false;
+  G4bool                        fFastValid  = false;
+  PEFastSource                  fFastSource;
 
 };
 
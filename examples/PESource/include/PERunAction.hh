@@ -1,10 +1,12 @@
 #ifndef PERunAction_h
 #define PERunAction_h 1
 
+#include "G4GenericMessenger.hh"
 #include "G4UserRunAction.hh"
 #include "globals.hh"
 
 class G4Run;
+class PEPrimaryGeneratorAction;
 
 /// Run action class
 ///
@@ -12,14 +14,19 @@ class G4Run;
 class PERunAction : public G4UserRunAction
 {
 public:
-  PERunAction(G4String name);
+  PERunAction(G4String name, PEPrimaryGeneratorAction* primary = nullptr);
   virtual ~PERunAction();
 
   virtual void BeginOfRunAction(const G4Run*);
   virtual void EndOfRunAction(const G4Run*);
 
 private:
-  G4String         fout;          // output file name
+  void DefineCommands();
+
+  G4String            fout;              // output file name
+  G4String            fPhaseSpace;       // phase-space file name
+  G4GenericMessenger* fMessenger = nullptr;
+  PEPrimaryGeneratorAction* fPrimary;    // worker threads only
 };
 
 
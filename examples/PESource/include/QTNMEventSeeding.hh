@@ -0,0 +1,61 @@
+// QTNMEventSeeding
+//
+//----------------------------------------------------------------------------
+//
+// Event-level random seeding and event ranges from the command line,
+// shared by the application mains.
+//
+//   -s,--seed <n>         global seed, used as 1234 + n
+//   --first-event <n>     global ID of the first event of this process
+//   --n-events <n>        start a run of n events after the macro, which
+//                         then only configures; 0 to leave it to the macro
+//
+// The generators call SeedEvent() first: it reseeds the thread's engine
+// from (seed, run ID, global event ID), global event ID being first event
+// + event ID. An event hence draws the same random numbers whichever
+// thread or process generates it, and the output EventID columns hold the
+// global ID. A production of N events split into jobs with --first-event
+// k*n --n-events n gives the same events, row by row once sorted by
+// EventID, as a single run of N events with any number of threads.
+// Outputs hold the global ID in 32 bits, so it may not exceed 2^31 - 1:
+// larger ranges are rejected, and an event beyond is a fatal error.
+//
+
+#ifndef QTNMEventSeeding_h
+#define QTNMEventSeeding_h 1
+
+#include "globals.hh"
+
+class G4Event;
+
+namespace CLI
+{
+  class App;
+}
+
+
+struct QTNMEventSeeding
+{
+  long seed       = 1234;
+  long firstEvent = 0;
+  long nEvents    = 0;
+
+  // register the options above
+  void AddOptions(CLI::App& app);
+
+  // seed the master engine and set the event offset, before the run manager
+  void Apply() const;
+
+  // global seed, 1234 + --seed
+  static G4long Seed();
+
+  // event ID within the whole production
+  static G4long EventID(const G4Event* event);
+
+  // reseed this thread's engine for the event, or a numbered part of it
+  // tracked separately (sub-event > 0)
+  static void SeedEvent(const G4Event* event, G4int subEvent = 0);
+};
+
+
+#endif
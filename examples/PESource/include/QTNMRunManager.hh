@@ -0,0 +1,57 @@
+// QTNMRunManager
+//
+//----------------------------------------------------------------------------
+//
+// Run manager choice and event scheduling from the command line, shared
+// by the application mains.
+//
+//   --runManager default|serial|mt|tasking   G4RunManagerFactory type;
+//                                             default follows the Geant4
+//                                             build and G4RUN_MANAGER_TYPE
+//   -t,--nthreads <n>                         worker threads or thread pool
+//                                             size, 0 for all cores
+//   --oversubscribe                           allow more threads than cores
+//   --eventModulo <n>                         events per request from the
+//                                             master, 0 for the automatic
+//                                             sqrt(events / threads)
+//   --seedOnce 0|1|2                          seeds per event, per batch of
+//                                             eventModulo events or per run
+//   --grainsize <n>                           tasking: events per task, 0
+//                                             for the Geant4 default
+//
+// Small batches (eventModulo 1) balance runs with very uneven event costs,
+// e.g. trapped next to untrapped electrons, at the price of more
+// communication with the master.
+//
+
+#ifndef QTNMRunManager_h
+#define QTNMRunManager_h 1
+
+#include <string>
+
+class G4RunManager;
+
+namespace CLI
+{
+  class App;
+}
+
+
+struct QTNMRunManager
+{
+  std::string type          = "default";
+  int         nthreads      = 4;
+  bool        oversubscribe = false;
+  int         eventModulo   = 0;
+  int         seedOnce      = 0;
+  int         grainsize     = 0;
+
+  // register the options above
+  void AddOptions(CLI::App& app);
+
+  // make and configure the run manager, reporting the choice
+  G4RunManager* Create() const;
+};
+
+
+#endif
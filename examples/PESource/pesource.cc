@@ -3,6 +3,7 @@
 
 // standard
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -20,62 +21,100 @@
 #include "G4UImanager.hh"
 #include "G4Threading.hh"
 #include "G4GenericPhysicsList.hh"
+#include "G4GeometrySampler.hh"
 #include "G4HadronicParameters.hh"
+#include "G4ImportanceBiasing.hh"
+#include "G4ParallelWorldPhysics.hh"
+#include "G4SystemOfUnits.hh"
 #include "G4VModularPhysicsList.hh"
 
 // us
 #include "CLI11.hpp"  // c++17 safe; https://github.com/CLIUtils/CLI11
 #include "PEActionInitialization.hh"
 #include "PEDetectorConstruction.hh"
+#include "QTNMBenchmark.hh"
+#include "QTNMEventSeeding.hh"
+#include "QTNMImportanceWorld.hh"
+#include "QTNMRunManager.hh"
+#include "QTNMStepMonitor.hh"
 
 int main(int argc, char** argv)
 {
   // command line interface
   CLI::App    app{ "Electron source for QTNM" };
-  int         nthreads = 4;
-  int         seed     = 1234;
   std::string outputFileName("phelectron.root");
   std::string macroName;
+  int         monitor  = 0;
+  std::string importance;
 
   app.add_option("-m,--macro", macroName, "<Geant4 macro filename> Default: None");
-  app.add_option("-s,--seed", seed, "<Geant4 random number seed + offset 1234> Default: 1234");
   app.add_option("-o,--outputFile", outputFileName,
                  "<FULL PATH ROOT FILENAME> Default: cd109.root");
-  app.add_option("-t, --nthreads", nthreads, "<number of threads to use> Default: 4");
+  QTNMRunManager runOptions;  // run manager type, threads and event batching
+  runOptions.AddOptions(app);
+  QTNMEventSeeding seeding;   // seed and event range of this process
+  seeding.AddOptions(app);
+  QTNMBenchmark benchmark;    // reference workloads instead of a macro
+  benchmark.workloads = {
+    { "ni-plate", "Ni plate, 22 keV gamma point source through the GPS",
+      {},
+      { "/run/verbose 0", "/tracking/verbose 0", "/gps/verbose 0", "/gps/particle gamma",
+        "/gps/ene/mono 22.0 keV", "/gps/pos/type Point", "/gps/pos/centre 0.0 0.0 -1.0 cm",
+        "/gps/direction 0.0 0.0 1.0" },
+      100, 10000 },
+    { "ni-plate-fast", "as ni-plate, with the per-thread fast source",
+      {},
+      { "/run/verbose 0", "/tracking/verbose 0", "/gps/verbose 0", "/gps/particle gamma",
+        "/gps/ene/mono 22.0 keV", "/gps/pos/type Point", "/gps/pos/centre 0.0 0.0 -1.0 cm",
+        "/gps/direction 0.0 0.0 1.0", "/PE/source/fast true" },
+      100, 10000 } };
+  benchmark.AddOptions(app);
+  app.add_option("--monitor", monitor,
+                 "<n> Step statistics per process and volume, timing 1 in n steps. Default: 0, off");
+  app.add_option("-i,--importance", importance,
+                 "<particle name> Importance biasing on /PE/importance/ slabs. Default: None");
 
   CLI11_PARSE(app, argc, argv);
 
+  // optional step statistics, set before the actions are built
+  QTNMStepMonitor::SetEnabled(monitor > 0);
+  QTNMStepMonitor::SetSampling(monitor);
+  benchmark.Prepare();  // counts steps unless monitored anyway
+
   // GEANT4 code
   // Get the pointer to the User Interface manager
   //
   G4UImanager* UImanager = G4UImanager::GetUIpointer();
 
   // Don't accept interactive mode (no macroName).
-  if(macroName.empty())
+  if(macroName.empty() && !benchmark.IsRequested())
   {
     G4cout << "No interactive mode running of example: provide a macro!" << G4endl;
     return 1;
   }
 
-  // set the random seed + offset 1234; avoiding zero seed -> runtime error
-  CLHEP::HepRandom::setTheSeed(1234+seed);
+  // seed from the command line, per event from (seed, run, global event ID)
+  seeding.Apply();
 
-  // -- Construct the run manager : MT or sequential one
-  auto* runManager = G4RunManagerFactory::CreateRunManager();
-#ifdef G4MULTITHREADED
-  nthreads =
-    std::min(nthreads, G4Threading::G4GetNumberOfCores());  // limit thread number to
-                                                            // max on machine
-  G4cout << "      ********* Run Manager constructed in MT mode: " << nthreads
-         << " threads ***** " << G4endl;
-  runManager->SetNumberOfThreads(nthreads);
-#endif
+  // -- Construct the run manager : serial, MT or tasking
+  auto* runManager = runOptions.Create();
 
 
   // -- Set mandatory initialization classes
   auto* detector = new PEDetectorConstruction;
   runManager->SetUserInitialization(detector);
 
+  // -- importance slabs in a parallel world, for one particle type
+  const G4String importanceWorld = "ImportanceWorld";
+  std::unique_ptr<G4GeometrySampler> sampler;
+  if(!importance.empty())
+  {
+    // slabs above the top face of the plate
+    detector->RegisterParallelWorld(new QTNMImportanceWorld(importanceWorld, "/PE/importance/",
+                                                            2.5 * mm));
+    sampler = std::make_unique<G4GeometrySampler>(nullptr, importance);
+    sampler->SetParallel(true);
+  }
 
   // -- set user physics list
   // Physics list factory
@@ -86,6 +125,12 @@ int main(int argc, char** argv)
   myConstructors->push_back("G4EmStandardPhysics_option4");
   physList = new G4GenericPhysicsList(myConstructors);
   
+  if(sampler)
+  {
+    physList->RegisterPhysics(new G4ImportanceBiasing(sampler.get(), importanceWorld));
+    physList->RegisterPhysics(new G4ParallelWorldPhysics(importanceWorld));
+  }
+
   // finish physics list
   runManager->SetUserInitialization(physList);
 
@@ -95,9 +140,21 @@ int main(int argc, char** argv)
   runManager->SetUserInitialization(actions);
 
 
+  // reference workload instead of the macro
+  if(benchmark.IsRequested())
+  {
+    int status = benchmark.Run(seeding.Seed());
+    delete runManager;
+    return status;
+  }
+
   // Batch mode only - no visualisation
   G4String command = "/control/execute ";
   UImanager->ApplyCommand(command + macroName);
+
+  // a range of a split production, the macro only configures
+  if(seeding.nEvents > 0)
+    UImanager->ApplyCommand("/run/beamOn " + std::to_string(seeding.nEvents));
   
   delete runManager;
   return 0;
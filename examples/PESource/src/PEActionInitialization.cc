@@ -2,6 +2,8 @@
 #include "PEEventAction.hh"
 #include "PEPrimaryGeneratorAction.hh"
 #include "PERunAction.hh"
+#include "QTNMStackingAction.hh"
+#include "QTNMStepMonitor.hh"
 
 
 PEActionInitialization::PEActionInitialization(G4String name)
@@ -19,8 +21,11 @@ void PEActionInitialization::BuildForMaster() const
 void PEActionInitialization::Build() const
 {
   // forward detector
-  SetUserAction(new PEPrimaryGeneratorAction());
+  auto primary = new PEPrimaryGeneratorAction();
+  SetUserAction(primary);
   auto event = new PEEventAction;
   SetUserAction(event);
-  SetUserAction(new PERunAction(foutname));
+  SetUserAction(new PERunAction(foutname, primary));
+  SetUserAction(new QTNMStackingAction("/PE/stack/"));
+  if(QTNMStepMonitor::IsEnabled()) SetUserAction(new QTNMStepMonitor);
 }
@@ -0,0 +1,155 @@
+#include "PEFastSource.hh"
+
+#include <cmath>
+
+#include "G4Event.hh"
+#include "G4GeneralParticleSource.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4RandomDirection.hh"
+#include "Randomize.hh"
+
+
+G4bool PEFastSource::Snapshot(G4GeneralParticleSource* gps)
+{
+  if(!gps || gps->GetNumberofSource() != 1) return false;
+
+  auto source = gps->GetCurrentSource();
+  auto pos    = source->GetPosDist();
+  auto ene    = source->GetEneDist();
+  auto ang    = source->GetAngDist();
+
+  fParticle   = source->GetParticleDefinition();
+  fNParticles = source->GetNumberOfParticles();
+  fTime       = source->GetParticleTime();
+  if(!fParticle) return false;
+
+  // position
+  fCentre = pos->GetCentreCoords();
+  fRotX   = pos->GetRotx();
+  fRotY   = pos->GetRoty();
+  fRotZ   = pos->GetRotz();
+  fHalfX  = pos->GetHalfX();
+  fHalfY  = pos->GetHalfY();
+  fRadius = pos->GetRadius();
+
+  G4String posType  = pos->GetPosDisType();
+  G4String posShape = pos->GetPosDisShape();
+  if(posType == "Point")
+    fPosType = Position::Point;
+  else if(posType == "Plane" && posShape == "Circle")
+    fPosType = Position::Disc;
+  else if(posType == "Plane" && (posShape == "Square" || posShape == "Rectangle"))
+    fPosType = Position::Rectangle;
+  else if(posType == "Volume" && posShape == "Sphere")
+    fPosType = Position::Ball;
+  else if(posType == "Surface" && posShape == "Sphere")
+    fPosType = Position::Sphere;
+  else
+    return false;
+
+  // energy
+  fEnergy = ene->GetMonoEnergy();
+  fSigma  = ene->GetSE();
+
+  G4String eneType = ene->GetEnergyDisType();
+  if(eneType == "Mono")
+    fEneType = Energy::Mono;
+  else if(eneType == "Gauss")
+    fEneType = Energy::Gauss;
+  else
+    return false;
+
+  // direction
+  fDirection   = ang->GetDirection();
+  fCosThetaMin = std::cos(ang->GetMinTheta());
+  fCosThetaMax = std::cos(ang->GetMaxTheta());
+  fPhiMin      = ang->GetMinPhi();
+  fPhiMax      = ang->GetMaxPhi();
+
+  G4String angType = ang->GetDistType();
+  if(angType == "planar")
+    fAngType = Angle::Beam;
+  else if(angType == "iso")
+    fAngType = Angle::Iso;
+  else
+    return false;
+
+  return true;
+}
+
+G4ThreeVector PEFastSource::SamplePosition() const
+{
+  G4double x = 0., y = 0., z = 0.;
+  switch(fPosType)
+  {
+    case Position::Point:
+      return fCentre;
+
+    case Position::Disc:
+      do
+      {
+        x = fRadius * (2. * G4UniformRand() - 1.);
+        y = fRadius * (2. * G4UniformRand() - 1.);
+      } while(x * x + y * y > fRadius * fRadius);
+      break;
+
+    case Position::Rectangle:
+      x = fHalfX * (2. * G4UniformRand() - 1.);
+      y = fHalfY * (2. * G4UniformRand() - 1.);
+      break;
+
+    case Position::Ball:
+      do
+      {
+        x = fRadius * (2. * G4UniformRand() - 1.);
+        y = fRadius * (2. * G4UniformRand() - 1.);
+        z = fRadius * (2. * G4UniformRand() - 1.);
+      } while(x * x + y * y + z * z > fRadius * fRadius);
+      break;
+
+    case Position::Sphere:
+    {
+      G4ThreeVector u = fRadius * G4RandomDirection();
+      x = u.x();
+      y = u.y();
+      z = u.z();
+      break;
+    }
+  }
+  return fCentre + x * fRotX + y * fRotY + z * fRotZ;
+}
+
+G4ThreeVector PEFastSource::SampleDirection() const
+{
+  if(fAngType == Angle::Beam) return fDirection;
+
+  // GPS convention: isotropic directions point inwards
+  G4double cosTheta = fCosThetaMin - G4UniformRand() * (fCosThetaMin - fCosThetaMax);
+  G4double sinTheta = std::sqrt(1. - cosTheta * cosTheta);
+  G4double phi      = fPhiMin + (fPhiMax - fPhiMin) * G4UniformRand();
+  return G4ThreeVector(-sinTheta * std::cos(phi), -sinTheta * std::sin(phi), -cosTheta);
+}
+
+void PEFastSource::GeneratePrimaryVertex(G4Event* event) const
+{
+  // one vertex per particle, as the GPS does
+  for(G4int i = 0; i < fNParticles; ++i)
+  {
+    G4double energy = fEnergy;
+    if(fEneType == Energy::Gauss)
+    {
+      energy = G4RandGauss::shoot(fEnergy, fSigma);
+      if(energy < 0.) energy = 0.;
+    }
+
+    auto particle = new G4PrimaryParticle(fParticle);
+    particle->SetKineticEnergy(energy);
+    particle->SetMomentumDirection(SampleDirection());
+    particle->SetCharge(fParticle->GetPDGCharge());
+
+    auto vertex = new G4PrimaryVertex(SamplePosition(), fTime);
+    vertex->SetPrimary(particle);
+    event->AddPrimaryVertex(vertex);
+  }
+}
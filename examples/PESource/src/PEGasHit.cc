@@ -12,7 +12,8 @@ PEGasHit::PEGasHit()
    fPz(0.),
    fPosx(0.),
    fPosy(0.),
-   fPosz(0.)
+   fPosz(0.),
+   fWeight(1.)
 {}
 
 PEGasHit::~PEGasHit() {}
@@ -29,6 +30,7 @@ PEGasHit::PEGasHit(const PEGasHit& right)
   fPosx         = right.fPosx;
   fPosy         = right.fPosy;
   fPosz         = right.fPosz;
+  fWeight       = right.fWeight;
 }
 
 const PEGasHit& PEGasHit::operator=(const PEGasHit& right)
@@ -42,6 +44,7 @@ const PEGasHit& PEGasHit::operator=(const PEGasHit& right)
   fPosx         = right.fPosx;
   fPosy         = right.fPosy;
   fPosz         = right.fPosz;
+  fWeight       = right.fWeight;
 
   return *this;
 }
@@ -1,5 +1,6 @@
 // us
 #include "PEPrimaryGeneratorAction.hh"
+#include "QTNMEventSeeding.hh"
 
 // geant
 #include "G4Event.hh"
@@ -25,15 +26,55 @@ PEPrimaryGeneratorAction::PEPrimaryGeneratorAction()
   fParticleGPS->GetCurrentSource()->GetEneDist()->SetMonoEnergy(22.*keV); // candidate energy, say roughly Cd-109 source
   fParticleGPS->GetCurrentSource()->GetAngDist()->SetParticleMomentumDirection(G4ThreeVector(0.,0.,1.)); // up z-axis
 
+  DefineCommands();
 }
 
 PEPrimaryGeneratorAction::~PEPrimaryGeneratorAction()
 {
+  delete fMessenger;
   delete fParticleGPS;
 }
 
+void PEPrimaryGeneratorAction::BeginOfRun()
+{
+  fFastValid = false;
+  if(!fUseFast) return;
+
+  fFastValid = fFastSource.Snapshot(fParticleGPS);
+  if(!fFastValid)
+  {
+    G4ExceptionDescription msg;
+    msg << "GPS configuration not supported by the fast source,"
+        << " using the GPS for this run.";
+    G4Exception("PEPrimaryGeneratorAction::BeginOfRun()", "PE0001",
+                JustWarning, msg);
+  }
+}
+
 void PEPrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
 {
+  // random numbers of this event independent of thread and job
+  QTNMEventSeeding::SeedEvent(event);
+
+  if(fFastValid)
+  {
+    fFastSource.GeneratePrimaryVertex(event);
+    return;
+  }
+
   // simply run the general particle source, all commands from macro
   fParticleGPS->GeneratePrimaryVertex(event);
 }
+
+void PEPrimaryGeneratorAction::DefineCommands()
+{
+  // Define /PE/source command directory using generic messenger class
+  fMessenger =
+    new G4GenericMessenger(this, "/PE/source/", "Primary source control");
+
+  auto& fastCmd = fMessenger->DeclareProperty("fast", fUseFast,
+                                              "Sample a per-thread copy of the /gps/ settings.");
+  fastCmd.SetGuidance("The copy is taken at the start of each run.");
+  fastCmd.SetParameterName("flag", true);
+  fastCmd.SetDefaultValue("true");
+}
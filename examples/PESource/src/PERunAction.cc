@@ -1,14 +1,21 @@
 #include "PERunAction.hh"
+#include "PEPrimaryGeneratorAction.hh"
 
 #include "G4Run.hh"
 #include "G4RunManager.hh"
 #include "G4AnalysisManager.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4UnitsTable.hh"
+#include "QTNMImportanceWorld.hh"
+#include "QTNMPhaseSpace.hh"
+#include "QTNMStackingAction.hh"
+#include "QTNMStepMonitor.hh"
+#include "QTNMTelemetry.hh"
 
-PERunAction::PERunAction(G4String name)
+PERunAction::PERunAction(G4String name, PEPrimaryGeneratorAction* primary)
 : G4UserRunAction()
 , fout(std::move(name))
+, fPrimary(primary)
 {
   // Create analysis manager
   auto analysisManager = G4AnalysisManager::Instance();
@@ -31,21 +38,46 @@ PERunAction::PERunAction(G4String name)
   analysisManager->CreateNtupleDColumn("Posx");
   analysisManager->CreateNtupleDColumn("Posy");
   analysisManager->CreateNtupleDColumn("Posz");
+  analysisManager->CreateNtupleDColumn("Weight");
   analysisManager->FinishNtuple();
 
+  DefineCommands();
 }
 
 // run manager deletes analysis manager, example AnaEx01
-PERunAction::~PERunAction() = default;
+PERunAction::~PERunAction()
+{
+  delete fMessenger;
+}
 
-void PERunAction::BeginOfRunAction(const G4Run* /*run*/)
+void PERunAction::BeginOfRunAction(const G4Run* run)
 {
+  // progress and throughput, workers only count events
+  if(IsMaster()) QTNMTelemetry::BeginOfRun(run->GetNumberOfEventToBeProcessed());
+
+  // source configuration is fixed for the run
+  if(fPrimary) fPrimary->BeginOfRun();
+
   // Get analysis manager
   auto analysisManager = G4AnalysisManager::Instance();
 
   // Open an output file
   //
   analysisManager->OpenFile(fout);
+
+  // phase-space file, shared by all threads; its records carry no weight,
+  // so a replay of a biased run would give biased spectra
+  if(IsMaster() && !fPhaseSpace.empty() && fPhaseSpace != "none")
+  {
+    if(QTNMImportanceWorld::InUse())
+    {
+      G4ExceptionDescription msg;
+      msg << "Phase-space file " << fPhaseSpace << " requested in an importance-biased job;"
+          << " run without --importance to write one.";
+      G4Exception("PERunAction::BeginOfRunAction()", "PE0002", FatalErrorInArgument, msg);
+    }
+    QTNMPhaseSpaceWriter::Open(fPhaseSpace);
+  }
 }
 
 void PERunAction::EndOfRunAction(const G4Run* /*run*/)
@@ -57,4 +89,26 @@ void PERunAction::EndOfRunAction(const G4Run* /*run*/)
   //
   analysisManager->Write();
   analysisManager->CloseFile();
+
+  // workers end their runs before the master
+  QTNMPhaseSpaceWriter::Flush();
+  if(IsMaster()) QTNMPhaseSpaceWriter::Close();
+
+  // stacking rule counts and step statistics, merged as above
+  QTNMStackingAction::Flush();
+  if(IsMaster()) QTNMStackingAction::Report();
+  QTNMStepMonitor::Flush();
+  if(IsMaster()) QTNMStepMonitor::Report();
+
+  if(IsMaster()) QTNMTelemetry::EndOfRun("none");
+}
+
+void PERunAction::DefineCommands()
+{
+  // Define /PE/run command directory using generic messenger class
+  fMessenger = new G4GenericMessenger(this, "/PE/run/", "Run control");
+
+  fMessenger->DeclareProperty("phaseSpace", fPhaseSpace,
+                              "Also write scored particles to this phase-space file, none to stop.")
+    .SetStates(G4State_PreInit, G4State_Idle);
 }
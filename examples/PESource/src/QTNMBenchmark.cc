@@ -0,0 +1,170 @@
+// QTNMBenchmark
+//
+//----------------------------------------------------------------------------
+//
+
+#include "QTNMBenchmark.hh"
+#include "QTNMStepMonitor.hh"
+#include "QTNMTelemetry.hh"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "CLI11.hpp"
+#include "G4UImanager.hh"
+#include "G4Version.hh"
+#include "G4ios.hh"
+
+
+namespace
+{
+  G4bool Apply(const std::string& command)
+  {
+    if(G4UImanager::GetUIpointer()->ApplyCommand(command) == 0) return true;
+
+    G4ExceptionDescription msg;
+    msg << "Benchmark command failed: " << command;
+    G4Exception("QTNMBenchmark::Run()", "QTNM0008", JustWarning, msg);
+    return false;
+  }
+
+  // number of a flat JSON object as written by Run(), -1 if missing
+  double Value(const std::string& json, const std::string& key)
+  {
+    auto pos = json.find("\"" + key + "\":");
+    if(pos == std::string::npos) return -1.;
+    return std::strtod(json.c_str() + pos + key.size() + 3, nullptr);
+  }
+}
+
+
+void QTNMBenchmark::AddOptions(CLI::App& app)
+{
+  std::vector<std::string> names;
+  std::string help = "<reference workload:";
+  for(const auto& workload : workloads)
+  {
+    names.push_back(workload.name);
+    help += " " + workload.name;
+  }
+  help += "> Run a benchmark instead of a macro";
+
+  app.add_option("--benchmark", name, help)->check(CLI::IsMember(names));
+  app.add_option("--benchmark-output", output,
+                 "<JSON result file> Default: benchmark_<name>.json");
+  app.add_option("--benchmark-baseline", baseline,
+                 "<JSON result file> Fail on a slow-down against it, skip if missing");
+  app.add_option("--benchmark-tolerance", tolerance,
+                 "<fraction> Allowed slow-down against the baseline. Default: 0.3")
+    ->check(CLI::Range(0., 1.));
+}
+
+void QTNMBenchmark::Prepare() const
+{
+  if(!IsRequested() || QTNMStepMonitor::IsEnabled()) return;
+  QTNMStepMonitor::SetEnabled(true);
+  QTNMStepMonitor::SetCountOnly(true);
+}
+
+int QTNMBenchmark::Run(long seed) const
+{
+  const Workload* workload = nullptr;
+  for(const auto& candidate : workloads)
+    if(candidate.name == name) workload = &candidate;
+  if(!workload) return 1;
+
+  G4cout << ">>> Benchmark " << workload->name << ": " << workload->description << G4endl;
+
+  for(const auto& command : workload->preInit)
+    if(!Apply(command)) return 1;
+
+  auto start = std::chrono::steady_clock::now();
+  if(!Apply("/run/initialize")) return 1;
+  std::chrono::duration<double> init = std::chrono::steady_clock::now() - start;
+
+  for(const auto& command : workload->commands)
+    if(!Apply(command)) return 1;
+
+  if(workload->warmup > 0 && !Apply("/run/beamOn " + std::to_string(workload->warmup)))
+    return 1;
+  if(!Apply("/run/beamOn " + std::to_string(workload->events))) return 1;
+
+  // the timed run is the last one
+  const auto& run   = QTNMTelemetry::LastRun();
+  double      steps = QTNMStepMonitor::LastSteps();
+  double      rate  = (run.wallTime > 0.) ? steps / run.wallTime : 0.;
+
+  std::string file = output.empty() ? "benchmark_" + workload->name + ".json" : output;
+  std::ofstream out(file);
+  if(!out)
+  {
+    G4ExceptionDescription msg;
+    msg << "Cannot write benchmark result " << file << ".";
+    G4Exception("QTNMBenchmark::Run()", "QTNM0008", JustWarning, msg);
+    return 1;
+  }
+  out << "{\n"
+      << "  \"benchmark\": \"" << workload->name << "\",\n"
+      << "  \"geant4\": \"" << G4Version << "\",\n"
+      << "  \"seed\": " << seed << ",\n"
+      << "  \"warmup_events\": " << workload->warmup << ",\n"
+      << "  \"init_time_s\": " << init.count() << ",\n"
+      << "  \"steps\": " << steps << ",\n"
+      << "  \"steps_per_s\": " << rate << ",\n";
+  QTNMTelemetry::WriteJSON(out, run);
+  out << "\n}\n";
+  out.close();
+
+  G4cout << ">>> Benchmark " << workload->name << ": " << run.rate << " events/s, " << rate
+         << " steps/s, initialisation " << init.count() << " s, written to " << file << G4endl;
+
+  if(baseline.empty()) return 0;
+  return CheckBaseline(file, init.count(), run.rate, run.threads);
+}
+
+int QTNMBenchmark::CheckBaseline(const std::string& result, double initTime, double rate,
+                                 int threads) const
+{
+  // nothing to compare with is not a pass, the baseline is recorded by hand
+  std::ifstream in(baseline);
+  if(!in)
+  {
+    G4cout << ">>> Benchmark " << name << ": no baseline " << baseline
+           << ", skipped; copy " << result << " there to record one" << G4endl;
+    return kSkipped;
+  }
+
+  std::stringstream text;
+  text << in.rdbuf();
+  std::string json        = text.str();
+  double      baseRate    = Value(json, "events_per_s");
+  double      baseInit    = Value(json, "init_time_s");
+  double      baseThreads = Value(json, "threads");
+  if(json.find("\"benchmark\": \"" + name + "\"") == std::string::npos || baseRate <= 0.
+     || baseInit < 0. || (int) baseThreads != threads)
+  {
+    G4ExceptionDescription msg;
+    msg << "Baseline " << baseline << " is not a result of benchmark " << name << " with "
+        << threads << " threads; copy " << result << " there to record a new one"
+        << " (PERF_BASELINE_DIR of the perf tests).";
+    G4Exception("QTNMBenchmark::CheckBaseline()", "QTNM0009", JustWarning, msg);
+    return 1;
+  }
+
+  // initialisation takes seconds at most, allow for jitter on top
+  G4bool slowRun  = rate < (1. - tolerance) * baseRate;
+  G4bool slowInit = initTime > (1. + tolerance) * baseInit + 0.5;
+  G4cout << ">>> Benchmark " << name << " against " << baseline << ": " << rate << " events/s ("
+         << baseRate << "), initialisation " << initTime << " s (" << baseInit << " s)" << G4endl;
+  if(!slowRun && !slowInit) return 0;
+
+  G4ExceptionDescription msg;
+  msg << "Performance regression of benchmark " << name << " against " << baseline << ":";
+  if(slowRun) msg << " " << rate << " events/s, baseline " << baseRate << ";";
+  if(slowInit) msg << " initialisation " << initTime << " s, baseline " << baseInit << " s;";
+  msg << " tolerance " << tolerance << ".";
+  G4Exception("QTNMBenchmark::CheckBaseline()", "QTNM0009", JustWarning, msg);
+  return 1;
+}
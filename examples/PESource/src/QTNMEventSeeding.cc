@@ -0,0 +1,97 @@
+// QTNMEventSeeding
+//
+//----------------------------------------------------------------------------
+//
+
+#include "QTNMEventSeeding.hh"
+
+#include "CLI11.hpp"
+#include "G4Event.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "G4ios.hh"
+#include "Randomize.hh"
+
+#include <limits>
+
+namespace
+{
+  // the EventID columns and phase-space records are 32 bit
+  const long maxEventID = std::numeric_limits<G4int>::max();
+
+  // set once on the master before any worker starts, read-only afterwards
+  G4long baseSeed    = 1234 + 1234;
+  G4long eventOffset = 0;
+
+  // the engine may keep a pointer to its seeds
+  G4ThreadLocal long eventSeeds[5] = { 0, 0, 0, 0, 0 };
+}
+
+
+void QTNMEventSeeding::AddOptions(CLI::App& app)
+{
+  app.add_option("-s,--seed", seed, "<Geant4 random number seed + offset 1234> Default: 1234");
+  app.add_option("--first-event", firstEvent,
+                 "<global ID of the first event, to split a production> Default: 0")
+    ->check(CLI::Range(0L, maxEventID));
+  app.add_option("--n-events", nEvents,
+                 "<events to run after the macro, 0 for the macro's own /run/beamOn> Default: 0")
+    ->check(CLI::Range(0L, maxEventID));
+}
+
+void QTNMEventSeeding::Apply() const
+{
+  if(nEvents > 0 && firstEvent > maxEventID - nEvents + 1)
+  {
+    G4ExceptionDescription msg;
+    msg << "Events " << firstEvent << " to " << firstEvent + nEvents - 1
+        << " reach beyond the largest event ID " << maxEventID << ".";
+    G4Exception("QTNMEventSeeding::Apply()", "QTNM0010", FatalErrorInArgument, msg);
+  }
+
+  // offset 1234 avoids a zero seed -> runtime error
+  baseSeed    = 1234 + seed;
+  eventOffset = firstEvent;
+  CLHEP::HepRandom::setTheSeed(baseSeed);
+
+  G4cout << "      ********* Events seeded from seed " << baseSeed
+         << ", first event " << eventOffset << " ***** " << G4endl;
+}
+
+G4long QTNMEventSeeding::Seed()
+{
+  return baseSeed;
+}
+
+G4long QTNMEventSeeding::EventID(const G4Event* event)
+{
+  return eventOffset + event->GetEventID();
+}
+
+void QTNMEventSeeding::SeedEvent(const G4Event* event, G4int subEvent)
+{
+  G4long id         = EventID(event);
+  if(id > maxEventID)
+  {
+    // a macro's /run/beamOn past the range --first-event allows
+    G4ExceptionDescription msg;
+    msg << "Global event ID " << id << " beyond the largest event ID " << maxEventID
+        << " of the outputs.";
+    G4Exception("QTNMEventSeeding::SeedEvent()", "QTNM0010", FatalException, msg);
+  }
+  auto   runManager = G4RunManager::GetRunManager();
+  G4int  runID      = (runManager && runManager->GetCurrentRun())
+                      ? runManager->GetCurrentRun()->GetRunID() : 0;
+
+  // MixMax stream from four 32 bit words, the full 64 bit event ID in the
+  // last two for events and sub-events alike; the sub-event shares a word
+  // with the run ID, distinct below 65536 runs and sub-events per event.
+  // The last word is odd, so streams never meet the QTNMPrimaryPool block
+  // streams (last word 0)
+  eventSeeds[0] = (long) (baseSeed & 0xffffffffL);
+  eventSeeds[1] = (long) ((runID ^ ((G4long) subEvent << 16)) & 0xffffffffL);
+  eventSeeds[2] = (long) (id & 0xffffffffL);
+  eventSeeds[3] = (long) (2 * (id >> 32) + 1);
+  eventSeeds[4] = 0;
+  G4Random::getTheEngine()->setSeeds(eventSeeds, 4);
+}
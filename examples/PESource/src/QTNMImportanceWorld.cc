@@ -0,0 +1,161 @@
+// QTNMImportanceWorld
+//
+//----------------------------------------------------------------------------
+//
+
+#include "QTNMImportanceWorld.hh"
+
+#include <cmath>
+
+#include "G4AutoLock.hh"
+#include "G4Box.hh"
+#include "G4GeometryCell.hh"
+#include "G4IntersectionSolid.hh"
+#include "G4IStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+#include "G4ios.hh"
+
+
+namespace
+{
+  // workers fill the store as their parallel world SDs are set up
+  G4Mutex importanceMutex = G4MUTEX_INITIALIZER;
+
+  // set in main(), before any worker starts
+  G4bool inUse = false;
+}
+
+QTNMImportanceWorld::QTNMImportanceWorld(const G4String& worldName,
+                                         const G4String& commandDir,
+                                         G4double origin)
+  : G4VUserParallelWorld(worldName)
+  , fOrigin(origin)
+  , fDmin(1. * um)
+  , fDmax(20. * mm)
+{
+  inUse = true;
+  DefineCommands(commandDir);
+}
+
+QTNMImportanceWorld::~QTNMImportanceWorld()
+{
+  delete fMessenger;
+}
+
+G4bool QTNMImportanceWorld::InUse()
+{
+  return inUse;
+}
+
+void QTNMImportanceWorld::Construct()
+{
+  G4VPhysicalVolume* ghostWorld = GetWorld();
+  G4LogicalVolume*   worldLog   = ghostWorld->GetLogicalVolume();
+  G4VSolid*          worldSolid = worldLog->GetSolid();
+
+  G4ThreeVector pmin, pmax;
+  worldSolid->BoundingLimits(pmin, pmax);
+
+  if(fDmin <= 0. || fDmax <= fDmin || fPlanes < 1 || fOrigin + fDmax >= pmax.z())
+  {
+    G4ExceptionDescription msg;
+    msg << "Invalid importance slabs: " << fPlanes << " planes between "
+        << fDmin / mm << " and " << fDmax / mm << " mm above z = " << fOrigin / mm
+        << " mm, world top at z = " << pmax.z() / mm << " mm.";
+    G4Exception("QTNMImportanceWorld::Construct()", "QTNM0005",
+                FatalErrorInArgument, msg);
+    return;
+  }
+
+  // plane heights, then the world top closing the last slab
+  std::vector<G4double> z(fPlanes + 1);
+  for(G4int i = 0; i < fPlanes; ++i)
+  {
+    G4double x = (fPlanes > 1) ? (G4double) i / (fPlanes - 1) : 1.;
+    z[i] = fOrigin + ((fSpacing == "log") ? fDmin * std::pow(fDmax / fDmin, x)
+                                          : fDmin + x * (fDmax - fDmin));
+  }
+  z[fPlanes] = pmax.z();
+
+  // slabs cut from the world solid, so they fill its full cross-section
+  G4double halfX = 0.5 * (pmax.x() - pmin.x());
+  G4double halfY = 0.5 * (pmax.y() - pmin.y());
+  fCells.assign(fPlanes + 1, nullptr);
+  fCells[0] = ghostWorld;
+  for(G4int i = 0; i < fPlanes; ++i)
+  {
+    G4String name    = "Importance_" + std::to_string(i);
+    auto     slab    = new G4Box(name + "_slab", halfX, halfY, 0.5 * (z[i + 1] - z[i]));
+    auto     solid   = new G4IntersectionSolid(name, worldSolid, slab, nullptr,
+                                               G4ThreeVector(0., 0., 0.5 * (z[i] + z[i + 1])));
+    auto     logical = new G4LogicalVolume(solid, nullptr, name + "_log");
+    fCells[i + 1] = new G4PVPlacement(nullptr, G4ThreeVector(), logical, name + "_phys",
+                                      worldLog, false, 0);
+  }
+
+  G4cout << ">> Importance world " << GetName() << ": " << fPlanes << " planes from "
+         << (z[0] - fOrigin) / mm << " to " << (z[fPlanes - 1] - fOrigin) / mm
+         << " mm above z = " << fOrigin / mm << " mm, importance ratio " << fRatio
+         << G4endl;
+}
+
+void QTNMImportanceWorld::ConstructSD()
+{
+  // importance 1 below the first plane, rising upward
+  G4AutoLock lock(&importanceMutex);
+  G4IStore* store = G4IStore::GetInstance(GetName());
+
+  G4double importance = 1.;
+  for(auto cell : fCells)
+  {
+    G4GeometryCell geometryCell(*cell, 0);
+    if(store->IsKnown(geometryCell))
+      store->ChangeImportance(importance, geometryCell);
+    else
+      store->AddImportanceGeometryCell(importance, geometryCell);
+    importance *= fRatio;
+  }
+}
+
+void QTNMImportanceWorld::DefineCommands(const G4String& commandDir)
+{
+  fMessenger = new G4GenericMessenger(this, commandDir, "Geometric importance biasing");
+
+  auto& planeCmd = fMessenger->DeclareProperty("planes", fPlanes,
+                                               "Number of importance planes.");
+  planeCmd.SetParameterName("n", false);
+  planeCmd.SetRange("n>0");
+  planeCmd.SetStates(G4State_PreInit);
+  planeCmd.SetToBeBroadcasted(false);
+
+  fMessenger->DeclarePropertyWithUnit("origin", "mm", fOrigin,
+                                      "z of the emitting source surface.")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclarePropertyWithUnit("dmin", "mm", fDmin,
+                                      "Height of the first plane above the source surface.")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclarePropertyWithUnit("dmax", "mm", fDmax,
+                                      "Height of the last plane, below the world top.")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+
+  auto& ratioCmd = fMessenger->DeclareProperty("ratio", fRatio,
+                                               "Importance ratio of neighbouring cells.");
+  ratioCmd.SetGuidance("Integer ratios split into exact copies.");
+  ratioCmd.SetParameterName("r", false);
+  ratioCmd.SetRange("r>=1.");
+  ratioCmd.SetStates(G4State_PreInit);
+  ratioCmd.SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("spacing", fSpacing, "Spacing of the planes along z.")
+    .SetCandidates("lin log")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+}
@@ -0,0 +1,208 @@
+// QTNMStepMonitor
+//
+//----------------------------------------------------------------------------
+//
+
+#include "QTNMStepMonitor.hh"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+#include "G4AutoLock.hh"
+#include "G4Event.hh"
+#include "G4EventManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Step.hh"
+#include "G4Threading.hh"
+#include "G4Track.hh"
+#include "G4UnitsTable.hh"
+#include "G4VProcess.hh"
+#include "G4ios.hh"
+
+
+G4bool QTNMStepMonitor::fgEnabled  = false;
+G4int  QTNMStepMonitor::fgSampling = 64;
+G4bool QTNMStepMonitor::fgCountOnly = false;
+
+namespace
+{
+  struct Total
+  {
+    G4double steps  = 0.;
+    G4double length = 0.;
+    G4double time   = 0.;
+  };
+
+  // run totals by (process, volume, particle) name, filled by all threads
+  using Names = std::tuple<G4String, G4String, G4String>;
+  G4Mutex                monitorMutex = G4MUTEX_INITIALIZER;
+  std::map<Names, Total> runTotals;
+  G4double               runSteps  = 0.;
+  G4double               lastSteps = 0.;
+
+  // this thread's monitor, to flush from the run action
+  G4ThreadLocal QTNMStepMonitor* threadInstance = nullptr;
+
+  // key bits: process slot, volume ID, particle ID
+  const std::uint64_t kBits = 21;
+  const std::uint64_t kMask = (std::uint64_t(1) << kBits) - 1;
+}
+
+QTNMStepMonitor::QTNMStepMonitor()
+  : G4UserSteppingAction()
+{
+  threadInstance = this;
+}
+
+QTNMStepMonitor::~QTNMStepMonitor()
+{
+  if(threadInstance == this) threadInstance = nullptr;
+}
+
+std::uint64_t QTNMStepMonitor::ProcessSlot(const G4VProcess* process)
+{
+  // a handful of processes per particle, a linear search is fastest
+  for(std::size_t i = 0; i < fProcesses.size(); ++i)
+    if(fProcesses[i] == process) return i;
+  fProcesses.push_back(process);
+  return fProcesses.size() - 1;
+}
+
+G4int QTNMStepMonitor::CurrentEventID()
+{
+  auto event = G4EventManager::GetEventManager()->GetConstCurrentEvent();
+  return event ? event->GetEventID() : -1;
+}
+
+void QTNMStepMonitor::UserSteppingAction(const G4Step* step)
+{
+  if(fgCountOnly)
+  {
+    fSteps += 1.;
+    return;
+  }
+
+  auto track    = step->GetTrack();
+  auto volume   = step->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume();
+  auto particle = track->GetDefinition();
+  auto process  = step->GetPostStepPoint()->GetProcessDefinedStep();
+
+  std::uint64_t volumeID   = volume->GetInstanceID();
+  std::uint64_t particleID = particle->GetParticleDefinitionID();
+  std::uint64_t key = (ProcessSlot(process) << (2 * kBits))
+                    | ((volumeID & kMask) << kBits) | (particleID & kMask);
+
+  // remember the objects behind the IDs for the report
+  if(volumeID >= fVolumes.size()) fVolumes.resize(volumeID + 1, nullptr);
+  fVolumes[volumeID] = volume;
+  if(particleID >= fParticles.size()) fParticles.resize(particleID + 1, nullptr);
+  fParticles[particleID] = particle;
+
+  auto& counter = fTable[key];
+  counter.steps  += 1.;
+  counter.length += step->GetStepLength();
+
+  // the timed step runs from the previous step of the same track to now;
+  // by IDs, a new track may reuse the memory of the sampled one
+  if(fSampledTrack >= 0)
+  {
+    if(fSampledTrack == track->GetTrackID()
+       && fSampledStep + 1 == track->GetCurrentStepNumber()
+       && fSampledEvent == CurrentEventID())
+    {
+      std::chrono::duration<G4double> dt = Clock::now() - fStart;
+      counter.time += dt.count() * fgSampling;
+    }
+    fSampledTrack = -1;
+  }
+  if(--fCountdown <= 0)
+  {
+    // next gap uniform in [1, 2n - 1], n on average
+    fJitter ^= fJitter << 13;
+    fJitter ^= fJitter >> 17;
+    fJitter ^= fJitter << 5;
+    fCountdown = 1 + fJitter % (2 * fgSampling - 1);
+    fSampledTrack = track->GetTrackID();
+    fSampledStep  = track->GetCurrentStepNumber();
+    fSampledEvent = CurrentEventID();
+    fStart        = Clock::now();
+  }
+}
+
+void QTNMStepMonitor::Flush()
+{
+  if(!threadInstance) return;
+  auto& self = *threadInstance;
+
+  G4AutoLock lock(&monitorMutex);
+  runSteps   += self.fSteps;
+  self.fSteps = 0.;
+  for(const auto& entry : self.fTable)
+  {
+    std::uint64_t slot       = entry.first >> (2 * kBits);
+    std::uint64_t volumeID   = (entry.first >> kBits) & kMask;
+    std::uint64_t particleID = entry.first & kMask;
+
+    auto process  = self.fProcesses[slot];
+    auto volume   = self.fVolumes[volumeID];
+    auto particle = self.fParticles[particleID];
+
+    Names names(process ? process->GetProcessName() : G4String("none"),
+                volume ? volume->GetName() : G4String("unknown"),
+                particle ? particle->GetParticleName() : G4String("unknown"));
+    auto& total = runTotals[names];
+    runSteps     += entry.second.steps;
+    total.steps  += entry.second.steps;
+    total.length += entry.second.length;
+    total.time   += entry.second.time;
+  }
+  self.fTable.clear();
+  self.fSampledTrack = -1;
+}
+
+void QTNMStepMonitor::Report()
+{
+  G4AutoLock lock(&monitorMutex);
+  lastSteps = runSteps;
+  runSteps  = 0.;
+  if(fgCountOnly)
+  {
+    G4cout << ">>> Step monitor: " << lastSteps << " steps" << G4endl;
+    return;
+  }
+  if(runTotals.empty()) return;
+
+  // most expensive first
+  std::vector<std::pair<Names, Total>> rows(runTotals.begin(), runTotals.end());
+  std::sort(rows.begin(), rows.end(),
+            [](const auto& a, const auto& b) { return a.second.time > b.second.time; });
+
+  G4double steps = 0., time = 0.;
+  for(const auto& row : rows)
+  {
+    steps += row.second.steps;
+    time  += row.second.time;
+  }
+
+  G4cout << ">>> Step monitor: " << steps << " steps, about " << time
+         << " s sampled tracking time (1 in " << fgSampling << " steps timed)" << G4endl;
+  G4cout << "    process / volume / particle: steps, track length, time [s], time share"
+         << G4endl;
+  for(const auto& row : rows)
+  {
+    const auto& names = row.first;
+    G4cout << "    " << std::get<0>(names) << " / " << std::get<1>(names) << " / "
+           << std::get<2>(names) << ": " << row.second.steps << ", "
+           << G4BestUnit(row.second.length, "Length") << ", " << row.second.time << ", "
+           << ((time > 0.) ? 100. * row.second.time / time : 0.) << " %" << G4endl;
+  }
+  runTotals.clear();
+}
+
+G4double QTNMStepMonitor::LastSteps()
+{
+  G4AutoLock lock(&monitorMutex);
+  return lastSteps;
+}
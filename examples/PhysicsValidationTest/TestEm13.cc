@@ -42,6 +42,7 @@
 #include "G4VModularPhysicsList.hh"
 #include "G4GenericPhysicsList.hh"
 #include "ActionInitialization.hh"
+#include "CrossSectionScan.hh"
 
 #include "G4UIExecutive.hh"
 #include "G4VisExecutive.hh"
@@ -88,6 +89,9 @@ int main(int argc,char** argv) {
 
   runManager->SetUserInitialization(new ActionInitialization(det));
 
+  //energy scan with G4EmCalculator, /testem/scan/ commands
+  CrossSectionScan* scan = new CrossSectionScan(det);
+
   //initialize visualization
   G4VisManager* visManager = nullptr;
 
@@ -109,6 +113,7 @@ int main(int argc,char** argv) {
   }
 
   //job termination
+  delete scan;
   delete visManager;
   delete runManager;
 }
@@ -0,0 +1,101 @@
+//
+//
+/// \file CrossSectionScan.hh
+/// \brief Definition of the CrossSectionScan class
+//
+// Cross sections per process on an energy grid, for a list of materials,
+// from G4EmCalculator instead of counting first interactions. Each
+// material is scanned in one run of one event per energy, so that the
+// worker threads share the energies; the events compute the cross
+// sections of their energy and track nothing (PrimaryGeneratorAction).
+// Optionally, a short transmission run as in run.mac checks every n-th
+// energy by Monte Carlo (Run::EndOfRun). Rows are appended to a table
+// file, list material particle energy process sigma error, and at the
+// end all physics lists found in the file are printed side by side, so
+// that scanning once per list (qtnm, standard, singleS) compares them.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef CrossSectionScan_h
+#define CrossSectionScan_h 1
+
+#include "globals.hh"
+#include <vector>
+
+class DetectorConstruction;
+class CrossSectionScanMessenger;
+class G4Material;
+class G4ParticleDefinition;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class CrossSectionScan
+{
+  public:
+    CrossSectionScan(DetectorConstruction*);
+   ~CrossSectionScan();
+
+  public:
+    void SetEnergies(G4double emin, G4double emax, G4int n);
+    void AddMaterial(const G4String& name) { fMaterials.push_back(name); };
+    void ClearMaterials()                  { fMaterials.clear(); };
+    void SetParticle(const G4String& name) { fParticleName = name; };
+    void SetMCEvents(G4int n)              { fMCEvents = n; };
+    void SetMCEvery(G4int n)               { fMCEvery = n; };
+    void SetOutput(const G4String& name)   { fOutput = name; };
+
+    // scan all materials, master only
+    void Scan();
+
+    // the scan in progress, nullptr if none
+    static CrossSectionScan* Current() { return fgCurrent; };
+
+    G4bool IsScanning() const { return fScanning; };
+    G4bool IsChecking() const { return fCheckPoint >= 0; };
+    G4int  NumberOfValues() const
+      { return (G4int)(fEnergies.size()*fProcesses.size()); };
+
+    // cross sections per mass of energy point, in sigma[point*nproc + j]
+    void Compute(G4int point, std::vector<G4double>& sigma) const;
+
+    // merged results of a scan run, and of a transmission check
+    void EndOfScanRun(const std::vector<G4double>& sigma);
+    void AddCheck(G4double sigma, G4double error);
+
+  private:
+    struct Row
+    {
+      G4String list, material, particle, process;
+      G4double energy, sigma, error;
+    };
+
+    void FindProcesses();
+    void Write();
+    void Compare() const;
+
+    DetectorConstruction*      fDetector  = nullptr;
+    CrossSectionScanMessenger* fMessenger = nullptr;
+
+    std::vector<G4double>  fEnergies;
+    std::vector<G4String>  fMaterials;
+    G4String               fParticleName = "e-";
+    G4int                  fMCEvents = 0;
+    G4int                  fMCEvery  = 10;
+    G4String               fOutput   = "crossSections.txt";
+
+    // set while scanning, read by the workers
+    const G4ParticleDefinition* fParticle = nullptr;
+    const G4Material*           fMaterial = nullptr;
+    std::vector<G4String>       fProcesses;
+    G4bool                      fScanning = false;
+    G4int                       fCheckPoint = -1;
+    G4String                    fList;
+    std::vector<Row>            fRows;
+
+    static CrossSectionScan* fgCurrent;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
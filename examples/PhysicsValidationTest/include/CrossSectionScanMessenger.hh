@@ -0,0 +1,50 @@
+//
+//
+/// \file CrossSectionScanMessenger.hh
+/// \brief Definition of the CrossSectionScanMessenger class
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef CrossSectionScanMessenger_h
+#define CrossSectionScanMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class CrossSectionScan;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithoutParameter;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class CrossSectionScanMessenger: public G4UImessenger
+{
+  public:
+
+    CrossSectionScanMessenger(CrossSectionScan* );
+   ~CrossSectionScanMessenger() override;
+
+    void SetNewValue(G4UIcommand*, G4String) override;
+
+  private:
+
+    CrossSectionScan*          fScan = nullptr;
+
+    G4UIdirectory*             fScanDir      = nullptr;
+    G4UIcommand*               fEnergiesCmd  = nullptr;
+    G4UIcmdWithAString*        fAddMatCmd    = nullptr;
+    G4UIcmdWithoutParameter*   fClearMatCmd  = nullptr;
+    G4UIcmdWithAString*        fParticleCmd  = nullptr;
+    G4UIcmdWithAnInteger*      fMCEventsCmd  = nullptr;
+    G4UIcmdWithAnInteger*      fMCEveryCmd   = nullptr;
+    G4UIcmdWithAString*        fOutputCmd    = nullptr;
+    G4UIcmdWithoutParameter*   fRunCmd       = nullptr;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -54,6 +54,7 @@ class PhysicsList: public G4VModularPhysicsList
     void ConstructParticle() override;
     void ConstructProcess() override;
     void AddPhysicsList(const G4String& name);
+    const G4String& GetEmName() const {return fEmName;};
     void SetCuts() override;
          
   private:
@@ -36,9 +36,11 @@
 #include "G4VUserPrimaryGeneratorAction.hh"
 #include "G4ParticleGun.hh"
 #include "globals.hh"
+#include <vector>
 
 class G4Event;
 class DetectorConstruction;
+class PrimaryGeneratorMessenger;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -52,9 +54,19 @@ class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
     void GeneratePrimaries(G4Event*) override;
     G4ParticleGun* GetParticleGun() {return fParticleGun;};
 
+    // energy list of a run, one energy per event, cycled or sampled;
+    // empty for the gun energy
+    void SetEnergies(const std::vector<G4double>&);
+    void SetSampleEnergies(G4bool sample) { fSampleEnergies = sample; };
+    const std::vector<G4double>& GetEnergies() const { return fEnergies; };
+
   private:
     G4ParticleGun*        fParticleGun = nullptr;
     DetectorConstruction* fDetector = nullptr;
+
+    std::vector<G4double>      fEnergies;
+    G4bool                     fSampleEnergies = false;
+    PrimaryGeneratorMessenger* fMessenger = nullptr;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -86,8 +86,9 @@ public:
   G4eDPWAElasticDCS* GetTheDCS() { return fTheDCS; }
 
 
-private:
+protected:
 
+  // hot functions, accessible to test/modelBench.cc
   G4double CalculateInelastic(G4double, G4int);
   void     SampleElasticSecondaries(const G4MaterialCutsCouple*,
 				    const G4DynamicParticle*);
@@ -95,6 +96,8 @@ private:
 				      const G4MaterialCutsCouple*,
 				      const G4DynamicParticle*);
 
+private:
+
   // Indicates whether inelastic scattering must be added
   G4bool                     fAddInelastic;
   // Indicates which process, elastic or inelastic samples secondaries
@@ -35,10 +35,12 @@
 
 #include "G4Run.hh"
 #include "globals.hh"
-#include <map>
+#include <vector>
 
 class DetectorConstruction;
+class CrossSectionScan;
 class G4ParticleDefinition;
+class G4VProcess;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -49,17 +51,33 @@ class Run : public G4Run
    ~Run() override = default;
 
   public:
-    void SetPrimary(G4ParticleDefinition* particle, G4double energy);
-    void CountProcesses(G4String procName);
+    void SetPrimary(G4ParticleDefinition* particle, G4double energy,
+                    const std::vector<G4double>& energies);
+    void SetEnergyIndex(G4int index) { fEnergyIndex = index; };
+    void CountProcesses(const G4VProcess* process);
+    void ScanPoint(const CrossSectionScan*, G4int point);
     void Merge(const G4Run*) override;
     void EndOfRun();
 
   private:
+    G4int    Count(std::size_t proc, std::size_t energy) const
+      { return fProcCounter[proc*fEnergies.size() + energy]; };
+    G4double MassSigma(G4double energy, const G4String& procName) const;
+    void     TransmissionCurve();
+
     DetectorConstruction*  fDetector = nullptr;
     G4ParticleDefinition*  fParticle = nullptr;
-    G4double  fEkin = 0.;
 
-    std::map<G4String,G4int>  fProcCounter;
+    std::vector<G4double>  fEnergies;        // primary energies, one if no list
+    G4int                  fEnergyIndex = 0; // of the current event
+
+    // first interactions, per process and energy in [proc*nEnergies + energy];
+    // processes by pointer in this thread, by name when merged
+    std::vector<const G4VProcess*>  fProcesses;
+    std::vector<G4String>           fProcNames;
+    std::vector<G4int>              fProcCounter;
+
+    std::vector<G4double>  fScanSigma;   // energy scan, per point and process
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,252 @@
+//
+//
+/// \file CrossSectionScan.cc
+/// \brief Implementation of the CrossSectionScan class
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "CrossSectionScan.hh"
+#include "CrossSectionScanMessenger.hh"
+#include "DetectorConstruction.hh"
+#include "PhysicsList.hh"
+
+#include "G4EmCalculator.hh"
+#include "G4Gamma.hh"
+#include "G4Material.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UIcommand.hh"
+#include "G4UImanager.hh"
+#include "G4VProcess.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+CrossSectionScan* CrossSectionScan::fgCurrent = nullptr;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CrossSectionScan::CrossSectionScan(DetectorConstruction* det)
+:fDetector(det)
+{
+  fMessenger = new CrossSectionScanMessenger(this);
+  SetEnergies(10*eV, 100*keV, 41);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CrossSectionScan::~CrossSectionScan()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CrossSectionScan::SetEnergies(G4double emin, G4double emax, G4int n)
+{
+  if (emin <= 0. || emax < emin || n < 1) {
+    G4cout << "\n--> warning from CrossSectionScan::SetEnergies : invalid grid "
+           << emin/keV << " keV to " << emax/keV << " keV in " << n
+           << " points" << G4endl;
+    return;
+  }
+
+  // logarithmic grid
+  fEnergies.clear();
+  for (G4int i=0; i<n; ++i) {
+    G4double f = (n > 1) ? G4double(i)/(n-1) : 0.;
+    fEnergies.push_back(emin*std::pow(emax/emin, f));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CrossSectionScan::FindProcesses()
+{
+  // EM processes of the particle, as named in all threads
+  fProcesses.clear();
+  G4ProcessVector* plist = fParticle->GetProcessManager()->GetProcessList();
+  for (G4int i=0; i<(G4int)plist->size(); ++i) {
+    G4VProcess* proc = (*plist)[i];
+    if (proc->GetProcessType() == fElectromagnetic)
+      fProcesses.push_back(proc->GetProcessName());
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CrossSectionScan::Scan()
+{
+  fParticle = G4ParticleTable::GetParticleTable()->FindParticle(fParticleName);
+  if (!fParticle) {
+    G4cout << "\n--> warning from CrossSectionScan::Scan : particle "
+           << fParticleName << " not found" << G4endl;
+    return;
+  }
+  FindProcesses();
+
+  G4RunManager* runManager = G4RunManager::GetRunManager();
+  fList = static_cast<const PhysicsList*>(runManager->GetUserPhysicsList())
+          ->GetEmName();
+
+  std::vector<G4String> materials = fMaterials;
+  if (materials.empty()) materials.push_back(fDetector->GetMaterial()->GetName());
+
+  G4UImanager* UI = G4UImanager::GetUIpointer();
+  fgCurrent = this;
+  fRows.clear();
+  for (const auto& name : materials) {
+    UI->ApplyCommand("/testem/det/setMat " + name);
+    fMaterial = fDetector->GetMaterial();
+    if (fMaterial->GetName() != name) continue;
+
+    // cross sections, one event per energy shared by the threads
+    fScanning = true;
+    runManager->BeamOn((G4int)fEnergies.size());
+    fScanning = false;
+
+    // Monte Carlo transmission check of every n-th energy
+    if (fMCEvents > 0) {
+      UI->ApplyCommand("/testem/gun/energies none");
+      UI->ApplyCommand("/gun/particle " + fParticleName);
+      for (G4int i=0; i<(G4int)fEnergies.size(); i+=std::max(fMCEvery, 1)) {
+        fCheckPoint = i;
+        UI->ApplyCommand("/gun/energy "
+                         + G4UIcommand::ConvertToString(fEnergies[i]/keV) + " keV");
+        runManager->BeamOn(fMCEvents);
+      }
+      fCheckPoint = -1;
+    }
+  }
+  fgCurrent = nullptr;
+
+  Write();
+  Compare();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CrossSectionScan::Compute(G4int point, std::vector<G4double>& sigma) const
+{
+  G4EmCalculator emCalculator;
+  G4double energy  = fEnergies[point];
+  G4double density = fMaterial->GetDensity();
+  std::size_t nproc = fProcesses.size();
+
+  // as the verification in Run::EndOfRun
+  for (std::size_t j=0; j<nproc; ++j) {
+    G4double sigmaVolume = (fParticle == G4Gamma::Gamma())
+      ? emCalculator.ComputeCrossSectionPerVolume(energy,fParticle,
+                                                  fProcesses[j],fMaterial)
+      : emCalculator.GetCrossSectionPerVolume(energy,fParticle,
+                                              fProcesses[j],fMaterial);
+    sigma[point*nproc + j] = sigmaVolume/density;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CrossSectionScan::EndOfScanRun(const std::vector<G4double>& sigma)
+{
+  std::size_t nproc = fProcesses.size();
+  if (sigma.size() < fEnergies.size()*nproc) return;
+
+  const G4String& particle = fParticle->GetParticleName();
+  for (std::size_t i=0; i<fEnergies.size(); ++i) {
+    G4double total = 0.;
+    for (std::size_t j=0; j<nproc; ++j) {
+      G4double value = sigma[i*nproc + j];
+      total += value;
+      fRows.push_back({fList, fMaterial->GetName(), particle, fProcesses[j],
+                       fEnergies[i], value, 0.});
+    }
+    fRows.push_back({fList, fMaterial->GetName(), particle, "total",
+                     fEnergies[i], total, 0.});
+  }
+  G4cout << "\n CrossSectionScan: " << fEnergies.size() << " energies of "
+         << particle << " in " << fMaterial->GetName() << " with " << fList
+         << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CrossSectionScan::AddCheck(G4double sigma, G4double error)
+{
+  fRows.push_back({fList, fMaterial->GetName(), fParticle->GetParticleName(),
+                   "MC", fEnergies[fCheckPoint], sigma, error});
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CrossSectionScan::Write()
+{
+  std::ifstream previous(fOutput);
+  G4bool header = !previous.good();
+  previous.close();
+
+  std::ofstream out(fOutput, std::ios::app);
+  if (!out) {
+    G4cout << "\n--> warning from CrossSectionScan::Write : cannot write "
+           << fOutput << G4endl;
+    return;
+  }
+  if (header)
+    out << "# list material particle energy[keV] process sigma[cm2/g] error[cm2/g]\n";
+  out << std::setprecision(6);
+  for (const auto& row : fRows) {
+    out << row.list << " " << row.material << " " << row.particle << " "
+        << row.energy/keV << " " << row.process << " "
+        << row.sigma/(cm2/g) << " " << row.error/(cm2/g) << "\n";
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CrossSectionScan::Compare() const
+{
+  // all rows of the table file, the last one of each list wins
+  std::ifstream in(fOutput);
+  std::vector<G4String> lists, keys;
+  std::map<G4String, std::map<G4String, G4String> > values;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream words(line);
+    std::string list, material, particle, energy, process, sigma, error;
+    if (!(words >> list >> material >> particle >> energy >> process >> sigma >> error))
+      continue;
+
+    std::ostringstream key;
+    key << std::setw(12) << material << std::setw(10) << particle
+        << std::setw(12) << energy << std::setw(14) << process;
+    if (values.find(key.str()) == values.end()) keys.push_back(key.str());
+    if (std::find(lists.begin(), lists.end(), list) == lists.end())
+      lists.push_back(list);
+    values[key.str()][list] = (process == "MC") ? sigma + "+-" + error : sigma;
+  }
+
+  G4cout << "\n ================ cross section comparison, cm2/g ================\n"
+         << "\n" << std::setw(12) << "material" << std::setw(10) << "particle"
+         << std::setw(12) << "E[keV]" << std::setw(14) << "process";
+  for (const auto& list : lists) G4cout << std::setw(24) << list;
+  G4cout << G4endl;
+  for (const auto& key : keys) {
+    G4cout << key;
+    for (const auto& list : lists) {
+      auto it = values[key].find(list);
+      G4cout << std::setw(24) << ((it == values[key].end()) ? G4String("-") : it->second);
+    }
+    G4cout << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,140 @@
+//
+//
+/// \file CrossSectionScanMessenger.cc
+/// \brief Implementation of the CrossSectionScanMessenger class
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "CrossSectionScanMessenger.hh"
+
+#include "CrossSectionScan.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CrossSectionScanMessenger::CrossSectionScanMessenger(CrossSectionScan* scan)
+:fScan(scan)
+{
+  fScanDir = new G4UIdirectory("/testem/scan/");
+  fScanDir->SetGuidance("cross sections from G4EmCalculator on an energy grid");
+
+  fEnergiesCmd = new G4UIcommand("/testem/scan/energies",this);
+  fEnergiesCmd->SetGuidance("Set logarithmic energy grid: emin emax points unit");
+  G4UIparameter* eminPrm = new G4UIparameter("emin",'d',false);
+  eminPrm->SetParameterRange("emin>0.");
+  fEnergiesCmd->SetParameter(eminPrm);
+  G4UIparameter* emaxPrm = new G4UIparameter("emax",'d',false);
+  emaxPrm->SetParameterRange("emax>0.");
+  fEnergiesCmd->SetParameter(emaxPrm);
+  G4UIparameter* nPrm = new G4UIparameter("points",'i',false);
+  nPrm->SetParameterRange("points>0");
+  fEnergiesCmd->SetParameter(nPrm);
+  G4UIparameter* unitPrm = new G4UIparameter("unit",'s',true);
+  unitPrm->SetDefaultUnit("keV");
+  fEnergiesCmd->SetParameter(unitPrm);
+  fEnergiesCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fEnergiesCmd->SetToBeBroadcasted(false);
+
+  fAddMatCmd = new G4UIcmdWithAString("/testem/scan/addMaterial",this);
+  fAddMatCmd->SetGuidance("Add a material to scan, by default the box material.");
+  fAddMatCmd->SetParameterName("material",false);
+  fAddMatCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fAddMatCmd->SetToBeBroadcasted(false);
+
+  fClearMatCmd = new G4UIcmdWithoutParameter("/testem/scan/clearMaterials",this);
+  fClearMatCmd->SetGuidance("Scan the box material only.");
+  fClearMatCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fClearMatCmd->SetToBeBroadcasted(false);
+
+  fParticleCmd = new G4UIcmdWithAString("/testem/scan/particle",this);
+  fParticleCmd->SetGuidance("Set scanned particle.");
+  fParticleCmd->SetParameterName("particle",false);
+  fParticleCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fParticleCmd->SetToBeBroadcasted(false);
+
+  fMCEventsCmd = new G4UIcmdWithAnInteger("/testem/scan/mcEvents",this);
+  fMCEventsCmd->SetGuidance("Events of the transmission checks, 0 for none.");
+  fMCEventsCmd->SetParameterName("events",false);
+  fMCEventsCmd->SetRange("events>=0");
+  fMCEventsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fMCEventsCmd->SetToBeBroadcasted(false);
+
+  fMCEveryCmd = new G4UIcmdWithAnInteger("/testem/scan/mcEvery",this);
+  fMCEveryCmd->SetGuidance("Check every n-th energy by transmission.");
+  fMCEveryCmd->SetParameterName("n",false);
+  fMCEveryCmd->SetRange("n>0");
+  fMCEveryCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fMCEveryCmd->SetToBeBroadcasted(false);
+
+  fOutputCmd = new G4UIcmdWithAString("/testem/scan/output",this);
+  fOutputCmd->SetGuidance("Set table file, rows are appended.");
+  fOutputCmd->SetParameterName("file",false);
+  fOutputCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fOutputCmd->SetToBeBroadcasted(false);
+
+  fRunCmd = new G4UIcmdWithoutParameter("/testem/scan/run",this);
+  fRunCmd->SetGuidance("Scan all materials and compare with the table file.");
+  fRunCmd->AvailableForStates(G4State_Idle);
+  fRunCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CrossSectionScanMessenger::~CrossSectionScanMessenger()
+{
+  delete fEnergiesCmd;
+  delete fAddMatCmd;
+  delete fClearMatCmd;
+  delete fParticleCmd;
+  delete fMCEventsCmd;
+  delete fMCEveryCmd;
+  delete fOutputCmd;
+  delete fRunCmd;
+  delete fScanDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CrossSectionScanMessenger::SetNewValue(G4UIcommand* command,
+                                            G4String newValue)
+{
+  if( command == fEnergiesCmd )
+   { G4double emin, emax;
+     G4int n;
+     G4String unit;
+     std::istringstream is(newValue);
+     is >> emin >> emax >> n >> unit;
+     G4double factor = G4UIcommand::ValueOf(unit);
+     fScan->SetEnergies(emin*factor, emax*factor, n);}
+
+  if( command == fAddMatCmd )
+   { fScan->AddMaterial(newValue);}
+
+  if( command == fClearMatCmd )
+   { fScan->ClearMaterials();}
+
+  if( command == fParticleCmd )
+   { fScan->SetParticle(newValue);}
+
+  if( command == fMCEventsCmd )
+   { fScan->SetMCEvents(fMCEventsCmd->GetNewIntValue(newValue));}
+
+  if( command == fMCEveryCmd )
+   { fScan->SetMCEvery(fMCEveryCmd->GetNewIntValue(newValue));}
+
+  if( command == fOutputCmd )
+   { fScan->SetOutput(newValue);}
+
+  if( command == fRunCmd )
+   { fScan->Scan();}
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -199,6 +199,7 @@ void DetectorConstruction::SetMaterial(G4String materialChoice)
   
   if (pttoMaterial) {
    fMaterial = pttoMaterial;
+   if (fLBox) fLBox->SetMaterial(fMaterial);
    G4RunManager::GetRunManager()->PhysicsHasBeenModified();
   } else {
     G4cout << "\n--> warning from DetectorConstruction::SetMaterial : "
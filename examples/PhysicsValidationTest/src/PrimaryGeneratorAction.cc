@@ -32,14 +32,20 @@
 
 #include "PrimaryGeneratorAction.hh"
 
+#include "CrossSectionScan.hh"
 #include "DetectorConstruction.hh"
+#include "PrimaryGeneratorMessenger.hh"
+#include "Run.hh"
 
 #include "G4Event.hh"
 #include "G4ParticleTable.hh"
 #include "G4ParticleDefinition.hh"
+#include "G4RunManager.hh"
 #include "G4SystemOfUnits.hh"
 #include "Randomize.hh"
 
+#include <algorithm>
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 PrimaryGeneratorAction::PrimaryGeneratorAction(DetectorConstruction* det)
@@ -51,6 +57,8 @@ PrimaryGeneratorAction::PrimaryGeneratorAction(DetectorConstruction* det)
   fParticleGun->SetParticleDefinition(particle);
   fParticleGun->SetParticleEnergy(1*MeV);    
   fParticleGun->SetParticleMomentumDirection(G4ThreeVector(1.,0.,0.));
+
+  fMessenger = new PrimaryGeneratorMessenger(this);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -58,6 +66,22 @@ PrimaryGeneratorAction::PrimaryGeneratorAction(DetectorConstruction* det)
 PrimaryGeneratorAction::~PrimaryGeneratorAction()
 {
   delete fParticleGun;
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetEnergies(const std::vector<G4double>& energies)
+{
+  for (G4double energy : energies) {
+    if (energy <= 0.) {
+      G4cout << "\n--> warning from PrimaryGeneratorAction::SetEnergies : "
+             << "energy " << energy/MeV << " MeV not positive, list unchanged"
+             << G4endl;
+      return;
+    }
+  }
+  fEnergies = energies;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -66,6 +90,28 @@ void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 {
   //this function is called at the begining of event
   //
+
+  //energy scan: cross sections of one energy per event, no primary
+  CrossSectionScan* scan = CrossSectionScan::Current();
+  if (scan && scan->IsScanning()) {
+    Run* run = static_cast<Run*>(
+               G4RunManager::GetRunManager()->GetNonConstCurrentRun());
+    run->ScanPoint(scan, anEvent->GetEventID());
+    return;
+  }
+
+  //energy list: in turn by event number, or at random
+  if (!fEnergies.empty()) {
+    std::size_t n = fEnergies.size();
+    std::size_t i = fSampleEnergies
+                  ? std::min(std::size_t(G4UniformRand()*n), n-1)
+                  : std::size_t(anEvent->GetEventID()) % n;
+    fParticleGun->SetParticleEnergy(fEnergies[i]);
+    Run* run = static_cast<Run*>(
+               G4RunManager::GetRunManager()->GetNonConstCurrentRun());
+    run->SetEnergyIndex((G4int)i);
+  }
+
   G4double halfSize = 0.5*(fDetector->GetSize());
   G4double x0 = - halfSize;
   
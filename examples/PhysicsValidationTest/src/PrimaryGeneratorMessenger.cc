@@ -0,0 +1,77 @@
+//
+//
+/// \file PrimaryGeneratorMessenger.cc
+/// \brief Implementation of the PrimaryGeneratorMessenger class
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "PrimaryGeneratorMessenger.hh"
+
+#include "PrimaryGeneratorAction.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIcmdWithAString.hh"
+
+#include <sstream>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PrimaryGeneratorMessenger::PrimaryGeneratorMessenger(PrimaryGeneratorAction* act)
+:fAction(act)
+{
+  fGunDir = new G4UIdirectory("/testem/gun/");
+  fGunDir->SetGuidance("primary energies of a run");
+
+  fEnergiesCmd = new G4UIcmdWithAString("/testem/gun/energies",this);
+  fEnergiesCmd->SetGuidance("Set energy list of the next runs: e1 e2 ... unit,");
+  fEnergiesCmd->SetGuidance("one energy per event and one summary per energy.");
+  fEnergiesCmd->SetGuidance("none: the /gun/energy of all events.");
+  fEnergiesCmd->SetParameterName("list",false);
+  fEnergiesCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fModeCmd = new G4UIcmdWithAString("/testem/gun/energyMode",this);
+  fModeCmd->SetGuidance("Take the energies of the list in turn or at random.");
+  fModeCmd->SetParameterName("mode",false);
+  fModeCmd->SetCandidates("cycle sample");
+  fModeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PrimaryGeneratorMessenger::~PrimaryGeneratorMessenger()
+{
+  delete fEnergiesCmd;
+  delete fModeCmd;
+  delete fGunDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorMessenger::SetNewValue(G4UIcommand* command,
+                                            G4String newValue)
+{
+  if( command == fEnergiesCmd )
+   { std::vector<G4String> words;
+     std::istringstream is(newValue);
+     G4String word;
+     while (is >> word) words.push_back(word);
+     std::vector<G4double> energies;
+     if (words.size() > 1) {
+       G4double factor = G4UIcommand::ValueOf(words.back());
+       for (std::size_t i=0; i<words.size()-1; ++i)
+         energies.push_back(G4UIcommand::ConvertToDouble(words[i])*factor);
+     }
+     else if (words.empty() || words[0] != "none") {
+       G4cout << "\n--> warning from PrimaryGeneratorMessenger::SetNewValue : "
+              << "energies without unit, list unchanged" << G4endl;
+       return;
+     }
+     fAction->SetEnergies(energies);}
+
+  if( command == fModeCmd )
+   { fAction->SetSampleEnergies(newValue == "sample");}
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
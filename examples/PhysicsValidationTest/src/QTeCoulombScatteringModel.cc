@@ -264,12 +264,16 @@ QTeCoulombScatteringModel::SampleInelasticSecondaries(std::vector<G4DynamicParti
   G4double rndm = rndmEngine->flat();
 
   auto lower = std::lower_bound(cdf.begin(), cdf.end(), rndm);
+  G4int i2 = std::distance(cdf.begin(), lower);
+
+  // below the first grid point the CDF rises from zero at zero energy
+  const G4double cdf1 = (i2 > 0) ? cdf[i2-1] : 0.0;
+  const G4double e1   = (i2 > 0) ? secondary_energy[i2-1] : 0.0;
 
-  G4double fac1 = (*lower - rndm) / (*lower - *(lower-1));
+  G4double fac1 = (*lower - rndm) / (*lower - cdf1);
   G4double fac2 = 1.0 - fac1;
 
-  G4int i2 = std::distance(cdf.begin(), lower);
-  G4double enew = fac1 * secondary_energy[i2-1] + fac2 * secondary_energy[i2];
+  G4double enew = fac1 * e1 + fac2 * secondary_energy[i2];
 
   // Original direction of particle
   G4ThreeVector dir = dp->GetMomentumDirection();
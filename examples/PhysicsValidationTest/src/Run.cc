@@ -31,6 +31,7 @@
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 #include "Run.hh"
+#include "CrossSectionScan.hh"
 #include "DetectorConstruction.hh"
 #include "PrimaryGeneratorAction.hh"
 
@@ -38,7 +39,9 @@
 #include "G4SystemOfUnits.hh"
 #include "G4EmCalculator.hh"
 #include "G4Gamma.hh"
+#include "G4VProcess.hh"
 
+#include <algorithm>
 #include <iomanip>
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -49,56 +52,102 @@ Run::Run(DetectorConstruction* det)
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void Run::SetPrimary(G4ParticleDefinition* particle, G4double energy)
+void Run::SetPrimary(G4ParticleDefinition* particle, G4double energy,
+                     const std::vector<G4double>& energies)
 { 
   fParticle = particle;
-  fEkin = energy;
+  fEnergies = energies;
+  if (fEnergies.empty()) fEnergies.push_back(energy);
+  fEnergyIndex = 0;
 }
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void Run::CountProcesses(G4String procName) 
+void Run::CountProcesses(const G4VProcess* process) 
 {
-  std::map<G4String,G4int>::iterator it = fProcCounter.find(procName);
-  if ( it == fProcCounter.end()) {
-    fProcCounter[procName] = 1;
-  }
-  else {
-    fProcCounter[procName]++; 
+  //few processes: linear search by pointer, no string compare per step
+  std::size_t j = 0;
+  while (j < fProcesses.size() && fProcesses[j] != process) ++j;
+  if (j == fProcesses.size()) {
+    fProcesses.push_back(process);
+    fProcNames.push_back(process->GetProcessName());
+    fProcCounter.resize(fProcCounter.size() + fEnergies.size(), 0);
   }
+  fProcCounter[j*fEnergies.size() + fEnergyIndex]++;
 }
  
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void Run::ScanPoint(const CrossSectionScan* scan, G4int point)
+{
+  if ((G4int)fScanSigma.size() < scan->NumberOfValues())
+    fScanSigma.resize(scan->NumberOfValues(), 0.);
+  scan->Compute(point, fScanSigma);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void Run::Merge(const G4Run* run)
 {
   const Run* localRun = static_cast<const Run*>(run);
 
   // pass information about primary particle
   fParticle = localRun->fParticle;
-  fEkin     = localRun->fEkin;
+  fEnergies = localRun->fEnergies;
+  std::size_t nEnergies = fEnergies.size();
       
-  //map: processes count
-  std::map<G4String,G4int>::const_iterator it;
-  for (it = localRun->fProcCounter.begin(); 
-       it !=localRun->fProcCounter.end(); ++it) {
-       
-    G4String procName = it->first;
-    G4int localCount  = it->second;
-    if ( fProcCounter.find(procName) == fProcCounter.end()) {
-      fProcCounter[procName] = localCount;
+  //processes count, matched by name
+  for (std::size_t k = 0; k < localRun->fProcNames.size(); ++k) {
+    const G4String& procName = localRun->fProcNames[k];
+    std::size_t j = std::find(fProcNames.begin(), fProcNames.end(), procName)
+                    - fProcNames.begin();
+    if (j == fProcNames.size()) {
+      fProcNames.push_back(procName);
+      fProcCounter.resize(fProcCounter.size() + nEnergies, 0);
     }
-    else {
-      fProcCounter[procName] += localCount;
-    }         
+    for (std::size_t i = 0; i < nEnergies; ++i)
+      fProcCounter[j*nEnergies + i] += localRun->fProcCounter[k*nEnergies + i];
   }
+
+  //energy scan: each point is computed by one thread
+  if (fScanSigma.size() < localRun->fScanSigma.size())
+    fScanSigma.resize(localRun->fScanSigma.size(), 0.);
+  for (std::size_t i = 0; i < localRun->fScanSigma.size(); ++i)
+    fScanSigma[i] += localRun->fScanSigma[i];
   
   G4Run::Merge(run); 
 } 
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+G4double Run::MassSigma(G4double energy, const G4String& procName) const
+{
+  G4EmCalculator emCalculator;
+  G4Material* material = fDetector->GetMaterial();
+  G4double sigma = (fParticle == G4Gamma::Gamma())
+    ? emCalculator.ComputeCrossSectionPerVolume(energy,fParticle,
+                                                procName,material)
+    : emCalculator.GetCrossSectionPerVolume(energy,fParticle,
+                                            procName,material);
+  return sigma/material->GetDensity();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void Run::EndOfRun()
 {
+  //energy scan, nothing tracked
+  CrossSectionScan* scan = CrossSectionScan::Current();
+  if (scan && scan->IsScanning()) {
+    scan->EndOfScanRun(fScanSigma);
+    return;
+  }
+
+  //energy list, one table
+  if (fEnergies.size() > 1) {
+    TransmissionCurve();
+    return;
+  }
+
   G4int prec = 5;  
   G4int dfprec = G4cout.precision(prec);
   
@@ -108,10 +157,11 @@ void Run::EndOfRun()
   G4Material* material = fDetector->GetMaterial();
   G4double density     = material->GetDensity();
   G4double tickness = fDetector->GetSize();
+  G4double ekin     = fEnergies.empty() ? 0. : fEnergies[0];
      
   G4cout << "\n ======================== run summary ======================\n";
   G4cout << "\n The run is: " << numberOfEvent << " " << partName << " of "
-         << G4BestUnit(fEkin,"Energy") << " through " 
+         << G4BestUnit(ekin,"Energy") << " through " 
          << G4BestUnit(tickness,"Length") << " of "
          << material->GetName() << " (density: " 
          << G4BestUnit(density,"Volumic Mass") << ")" << G4endl;
@@ -120,10 +170,9 @@ void Run::EndOfRun()
   G4int totalCount = 0;
   G4int survive = 0;  
   G4cout << "\n Process calls frequency --->";
-  std::map<G4String,G4int>::iterator it;  
-  for (it = fProcCounter.begin(); it != fProcCounter.end(); it++) {
-     G4String procName = it->first;
-     G4int    count    = it->second;
+  for (std::size_t j = 0; j < fProcNames.size(); ++j) {
+     G4String procName = fProcNames[j];
+     G4int    count    = Count(j, 0);
      totalCount += count; 
      G4cout << "\t" << procName << " = " << count;
      if (procName == "Transportation") survive = count;
@@ -150,20 +199,18 @@ void Run::EndOfRun()
          << "\tCrossSection per mass: " << G4BestUnit(massicCS, "Surface/Mass")
          << G4endl;
 
+  //transmission check of an energy scan, binomial error
+  if (scan && scan->IsChecking()) {
+    G4double error = std::sqrt((1.-ratio)/(ratio*totalCount))/(tickness*density);
+    scan->AddCheck(massicCS, error);
+  }
+
   //check cross section from G4EmCalculator
   //
   G4cout << "\n Verification from G4EmCalculator: \n"; 
-  G4EmCalculator emCalculator;
   G4double sumc = 0.0;  
-  for (it = fProcCounter.begin(); it != fProcCounter.end(); it++) {
-    G4String procName = it->first;  
-    G4double massSigma = 
-    emCalculator.GetCrossSectionPerVolume(fEkin,fParticle,
-                                              procName,material)/density;
-    if (fParticle == G4Gamma::Gamma())
-       massSigma = 
-       emCalculator.ComputeCrossSectionPerVolume(fEkin,fParticle,
-                                              procName,material)/density;
+  for (const auto& procName : fProcNames) {
+    G4double massSigma = MassSigma(ekin, procName);
     sumc += massSigma;
     if (procName != "Transportation")
       G4cout << "\t" << procName << "= " 
@@ -177,11 +224,66 @@ void Run::EndOfRun()
   G4cout << "\tExpected ratio of transmitted particles= " 
          << 100*Ratio << " %" << G4endl;         
                         
-  // remove all contents in fProcCounter 
-  fProcCounter.clear();
-  
   //restore default format
   G4cout.precision(dfprec);  
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void Run::TransmissionCurve()
+{
+  G4int dfprec = G4cout.precision(5);
+
+  G4Material* material = fDetector->GetMaterial();
+  G4double density     = material->GetDensity();
+  G4double tickness    = fDetector->GetSize();
+
+  G4cout << "\n ==================== transmission curve ===================\n";
+  G4cout << "\n The run is: " << numberOfEvent << " "
+         << fParticle->GetParticleName() << " at " << fEnergies.size()
+         << " energies through " << G4BestUnit(tickness,"Length") << " of "
+         << material->GetName() << " (density: "
+         << G4BestUnit(density,"Volumic Mass") << ")" << G4endl;
+
+  //one row per energy: first interactions per process, transmitted
+  //fraction and cross section per mass (cm2/g, binomial error) against
+  //G4EmCalculator
+  G4cout << "\n" << std::setw(12) << "E[keV]";
+  for (const auto& procName : fProcNames)
+    if (procName != "Transportation") G4cout << std::setw(12) << procName;
+  G4cout << std::setw(12) << "incident" << std::setw(12) << "ratio[%]"
+         << std::setw(12) << "expected" << std::setw(12) << "sigma"
+         << std::setw(12) << "error" << std::setw(12) << "expected"
+         << G4endl;
+
+  for (std::size_t i = 0; i < fEnergies.size(); ++i) {
+    G4int totalCount = 0;
+    G4int survive = 0;
+    G4double sumc = 0.;
+    G4cout << std::setw(12) << fEnergies[i]/keV;
+    for (std::size_t j = 0; j < fProcNames.size(); ++j) {
+      G4int count = Count(j, i);
+      totalCount += count;
+      sumc += MassSigma(fEnergies[i], fProcNames[j]);
+      if (fProcNames[j] == "Transportation") survive = count;
+      else G4cout << std::setw(12) << count;
+    }
+    G4double ratio = (totalCount > 0) ? double(survive)/totalCount : 0.;
+    G4double expected = std::exp(-sumc*density*tickness);
+    G4cout << std::setw(12) << totalCount << std::setw(12) << 100*ratio
+           << std::setw(12) << 100*expected;
+    if (ratio > 0.) {
+      G4double massicCS = -std::log(ratio)/(tickness*density);
+      G4double error = std::sqrt((1.-ratio)/(ratio*totalCount))/(tickness*density);
+      G4cout << std::setw(12) << massicCS/(cm2/g) << std::setw(12) << error/(cm2/g);
+    }
+    else {
+      G4cout << std::setw(12) << "-" << std::setw(12) << "-";
+    }
+    G4cout << std::setw(12) << sumc/(cm2/g) << G4endl;
+  }
+
+  G4cout.precision(dfprec);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -66,7 +66,7 @@ void RunAction::BeginOfRunAction(const G4Run*)
     G4ParticleDefinition* particle 
       = fPrimary->GetParticleGun()->GetParticleDefinition();
     G4double energy = fPrimary->GetParticleGun()->GetParticleEnergy();
-    fRun->SetPrimary(particle, energy);
+    fRun->SetPrimary(particle, energy, fPrimary->GetEnergies());
   }
 }
 
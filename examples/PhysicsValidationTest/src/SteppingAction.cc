@@ -40,11 +40,10 @@
 void SteppingAction::UserSteppingAction(const G4Step* aStep)
 {
   G4StepPoint* endPoint = aStep->GetPostStepPoint();
-  G4String procName = endPoint->GetProcessDefinedStep()->GetProcessName();
 
   Run* run = static_cast<Run*>(
              G4RunManager::GetRunManager()->GetNonConstCurrentRun()); 
-  run->CountProcesses(procName);  
+  run->CountProcesses(endPoint->GetProcessDefinedStep());
            
   // kill event after first interaction
   //
@@ -0,0 +1,287 @@
+// ********************************************************************
+// QTeCoulombScatteringModel micro-benchmark
+//
+// Per-call cost of the model hot functions, ComputeCrossSectionPerAtom,
+// CalculateInelastic, SampleInelasticSecondaries and
+// SampleElasticSecondaries, for electrons in tritium gas on a grid from
+// 10 eV to 100 keV. Checks at each energy
+//  - the sampled secondary energies against the analytic RBEB CDF
+//    (Kolmogorov distance, 0.1% critical value plus the 200 point
+//    interpolation of the model),
+//  - the sampled mean 1 - cos(theta) of elastic scattering against
+//    the ratio of first transport to elastic cross section.
+// With a result file, the model initialisation time and the calls/s of
+// all four functions are written to it as JSON, and with a baseline file
+// the run fails if they are slower by more than the tolerance (default
+// 0.3, plus 0.5 s for the initialisation). A missing baseline is not
+// recorded, as for the --benchmark mode of the QTNM applications: the
+// checks still run, and the exit code is 77 (CTest skip) if they pass.
+// Exits with 1 if any check fails. Needs G4LEDATA.
+// Usage: modelBench [samples per energy] [seed] [result] [baseline] [tolerance]
+
+// standard
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Geant4
+#include "G4DataVector.hh"
+#include "G4DynamicParticle.hh"
+#include "G4Electron.hh"
+#include "G4Element.hh"
+#include "G4Isotope.hh"
+#include "G4Material.hh"
+#include "G4MaterialCutsCouple.hh"
+#include "G4ParticleChangeForGamma.hh"
+#include "G4ParticleTable.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4eDPWAElasticDCS.hh"
+#include "G4ios.hh"
+#include "Randomize.hh"
+
+// us
+#include "QTeCoulombScatteringModel.hh"
+
+namespace
+{
+  // access to the protected hot functions and the particle change
+  class BenchModel : public QTeCoulombScatteringModel
+  {
+  public:
+    BenchModel()
+    : QTeCoulombScatteringModel(false, false, 0.0)  // as in QTNMPhysicsList
+    {}
+
+    using QTeCoulombScatteringModel::CalculateInelastic;
+    using QTeCoulombScatteringModel::SampleElasticSecondaries;
+    using QTeCoulombScatteringModel::SampleInelasticSecondaries;
+
+    G4ParticleChangeForGamma* Change() { return GetParticleChangeForGamma(); }
+  };
+
+  // RBEB cross section integrated from zero to secondary energy w,
+  // up to a constant factor (Kim and Rudd, one shell). All in eV.
+  G4double RBEBIntegral(G4double T, G4double B, G4double W)
+  {
+    const G4double mc2    = 511e3;
+    const G4double tp     = T / mc2;
+    const G4double bp     = B / mc2;
+    const G4double betaT2 = 1. - 1. / ((1. + tp) * (1. + tp));
+    const G4double t      = T / B;
+    const G4double w      = W / B;
+    const G4double half   = (1. + 0.5 * tp) * (1. + 0.5 * tp);
+
+    G4double a1 = 0.5 * (1. / ((t - w) * (t - w)) - 1. / ((w + 1.) * (w + 1.))
+                         - 1. / (t * t) + 1.);
+    G4double a2 = std::log(betaT2 / (1. - betaT2)) - betaT2 - std::log(2. * bp);
+    G4double a3 = 1. / (t - w) - 1. / (w + 1.) - 1. / t + 1.;
+    G4double a4 = bp * bp / half * w;
+    G4double a5 = std::log(t * (w + 1.) / (t - w));
+    G4double a6 = (1. + 2. * tp) / half / (t + 1.);
+    return a1 * a2 + a3 + a4 - a5 * a6;
+  }
+
+  using Clock = std::chrono::steady_clock;
+
+  G4double NanoSince(Clock::time_point start, int n)
+  {
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / n;
+  }
+
+  // number of a flat JSON object as written below, -1 if missing
+  G4double Value(const std::string& json, const std::string& key)
+  {
+    auto pos = json.find("\"" + key + "\":");
+    if(pos == std::string::npos) return -1.;
+    return std::strtod(json.c_str() + pos + key.size() + 3, nullptr);
+  }
+
+  // exit code without a baseline file, CTest's SKIP_RETURN_CODE
+  const int kSkipped = 77;
+
+  // compare with the baseline, 0 if as fast, 1 if slower, kSkipped if missing
+  int CheckBaseline(const std::string& result, const std::string& baseline,
+                    G4double tolerance, G4double initTime, G4double rate)
+  {
+    std::ifstream in(baseline);
+    if(!in)
+    {
+      G4cout << "  no baseline " << baseline << ", skipped; copy " << result
+             << " there to record one" << G4endl;
+      return kSkipped;
+    }
+
+    std::stringstream text;
+    text << in.rdbuf();
+    G4double baseRate = Value(text.str(), "calls_per_s");
+    G4double baseInit = Value(text.str(), "init_time_s");
+    G4cout << "  against " << baseline << ": " << rate << " calls/s (" << baseRate
+           << "), initialisation " << initTime << " s (" << baseInit << " s)" << G4endl;
+    if(baseRate <= 0. || baseInit < 0.)
+    {
+      G4cout << "  baseline " << baseline << " unreadable" << G4endl;
+      return 1;
+    }
+    G4bool fast = rate >= (1. - tolerance) * baseRate
+                  && initTime <= (1. + tolerance) * baseInit + 0.5;
+    if(!fast) G4cout << "  PERFORMANCE REGRESSION, tolerance " << tolerance << G4endl;
+    return fast ? 0 : 1;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int  nSamples = (argc > 1) ? std::atoi(argv[1]) : 100000;
+  long seed     = (argc > 2) ? std::atol(argv[2]) : 1234;
+  std::string result    = (argc > 3) ? argv[3] : "";
+  std::string baseline  = (argc > 4) ? argv[4] : "";
+  G4double    tolerance = (argc > 5) ? std::atof(argv[5]) : 0.3;
+  if(nSamples <= 1 || (!baseline.empty() && result.empty())) return 1;
+  G4Random::setTheSeed(seed);
+
+  // electrons, no run manager required
+  G4Electron::Definition();
+  G4ParticleTable::GetParticleTable()->SetReadiness();
+  auto electron = G4Electron::Electron();
+
+  // tritium gas, density as in ScatteringExample
+  auto isotope = new G4Isotope("T", 1, 3, 3.016 * g / mole);
+  auto element = new G4Element("Tritium", "T", 1);
+  element->AddIsotope(isotope, 100. * perCent);
+  auto gas = new G4Material("TritiumGas", 5e-12 * g / cm3, 1, kStateGas);
+  gas->AddElement(element, 1);
+  G4MaterialCutsCouple couple(gas);
+
+  // master model; no couples in the cuts table, so the DCS is
+  // initialised for hydrogen by hand
+  BenchModel   model;
+  G4DataVector cuts;
+  auto initStart = Clock::now();
+  model.Initialise(electron, cuts);
+  model.GetTheDCS()->InitialiseForZ(1);
+  G4double initTime = 1e-9 * NanoSince(initStart, 1);
+
+  const G4double bind     = 13.6;  // eV, as in the model
+  const G4double dCrit    = 1.949 / std::sqrt((G4double) nSamples) + 1e-3;
+  const int      nPerDec  = 4;
+  const int      nEnergy  = 4 * nPerDec + 1;  // 10 eV to 100 keV
+  bool           passed   = true;
+  int            status   = 0;     // of the baseline comparison
+  G4double       checksum = 0.;
+  G4double       total    = 0.;  // ns in all timed calls
+
+  std::vector<G4DynamicParticle*> secondaries;
+  std::vector<G4double>           energies;
+  energies.reserve(nSamples);
+
+  G4cout << "modelBench: " << nSamples << " calls per energy, seed " << seed
+         << G4endl
+         << "  E [eV]   el [b]  inel [b]  CrossSection  Inelastic  "
+         << "SampleInel  SampleEl [ns/call]  D(RBEB)  <1-cos> [sigma]"
+         << G4endl;
+
+  for(int ie = 0; ie < nEnergy; ++ie)
+  {
+    const G4double ekin = 10. * eV * std::pow(10., (G4double) ie / nPerDec);
+    G4DynamicParticle primary(electron, G4ThreeVector(0., 0., 1.), ekin);
+
+    // cross sections, including the inelastic decision draw
+    auto start = Clock::now();
+    for(int i = 0; i < nSamples; ++i)
+      checksum += model.ComputeCrossSectionPerAtom(electron, ekin, 1., 3.016, 0., 0.);
+    G4double tCross = NanoSince(start, nSamples);
+
+    start = Clock::now();
+    for(int i = 0; i < nSamples; ++i)
+      checksum += model.CalculateInelastic(ekin, 1);
+    G4double tInel = NanoSince(start, nSamples);
+
+    G4double elCS = 0., tr1CS = 0., tr2CS = 0.;
+    model.GetTheDCS()->ComputeCSPerAtom(1, ekin, elCS, tr1CS, tr2CS, 0., 1.);
+    G4double inelCS = model.CalculateInelastic(ekin, 1);
+
+    // secondary energies, against the RBEB CDF
+    energies.clear();
+    start = Clock::now();
+    for(int i = 0; i < nSamples; ++i)
+    {
+      model.SampleInelasticSecondaries(&secondaries, &couple, &primary);
+      for(auto secondary : secondaries)
+      {
+        energies.push_back(secondary->GetKineticEnergy() / eV);
+        delete secondary;
+      }
+      secondaries.clear();
+    }
+    G4double tSampleInel = NanoSince(start, nSamples);
+
+    G4double distance = 0.;
+    if(!energies.empty())
+    {
+      const G4double T    = ekin / eV;
+      const G4double norm = RBEBIntegral(T, bind, 0.5 * (T - bind));
+      const G4double n    = (G4double) energies.size();
+      std::sort(energies.begin(), energies.end());
+      for(std::size_t i = 0; i < energies.size(); ++i)
+      {
+        G4double cdf = RBEBIntegral(T, bind, energies[i]) / norm;
+        distance     = std::max({ distance, std::abs(cdf - i / n), std::abs(cdf - (i + 1) / n) });
+      }
+      if(distance > dCrit) passed = false;
+    }
+
+    // deflections, against the transport cross section
+    G4double sum = 0., sum2 = 0.;
+    start = Clock::now();
+    for(int i = 0; i < nSamples; ++i)
+    {
+      model.SampleElasticSecondaries(&couple, &primary);
+      G4double mu = 1. - model.Change()->GetProposedMomentumDirection().z();
+      sum  += mu;
+      sum2 += mu * mu;
+    }
+    G4double tSampleEl = NanoSince(start, nSamples);
+    total += (tCross + tInel + tSampleInel + tSampleEl) * nSamples;
+
+    G4double mean  = sum / nSamples;
+    G4double error = std::sqrt(std::max(0., sum2 / nSamples - mean * mean) / (nSamples - 1));
+    G4double pull  = (elCS > 0. && error > 0.) ? (mean - tr1CS / elCS) / error : 0.;
+    if(std::abs(pull) > 5.) passed = false;
+
+    G4cout << "  " << ekin / eV << "  " << elCS / barn << "  " << inelCS / barn
+           << "  " << tCross << "  " << tInel << "  " << tSampleInel << "  "
+           << tSampleEl << "  ";
+    if(energies.empty()) G4cout << "-";
+    else G4cout << distance << (distance > dCrit ? " FAIL" : "");
+    G4cout << "  " << pull << (std::abs(pull) > 5. ? " FAIL" : "") << G4endl;
+  }
+
+  G4double rate = 4. * nSamples * nEnergy / (1e-9 * total);
+  G4cout << "  critical D " << dCrit << ", |pull| 5 (checksum " << checksum << ")"
+         << G4endl << "  initialisation " << initTime << " s, " << rate << " calls/s"
+         << G4endl;
+
+  if(!result.empty())
+  {
+    std::ofstream out(result);
+    out << "{\n"
+        << "  \"benchmark\": \"modelBench\",\n"
+        << "  \"samples\": " << nSamples << ",\n"
+        << "  \"seed\": " << seed << ",\n"
+        << "  \"init_time_s\": " << initTime << ",\n"
+        << "  \"calls_per_s\": " << rate << "\n"
+        << "}\n";
+    out.close();
+    if(!out) passed = false;
+    else if(!baseline.empty()) status = CheckBaseline(result, baseline, tolerance, initTime, rate);
+  }
+
+  G4cout << (passed ? "  all checks passed" : "  CHECKS FAILED") << G4endl;
+  return passed ? status : 1;
+}
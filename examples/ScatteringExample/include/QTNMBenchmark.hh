@@ -0,0 +1,80 @@
+// QTNMBenchmark
+//
+//----------------------------------------------------------------------------
+//
+// Reference workloads to catch performance regressions, run from the
+// command line instead of a macro.
+//
+//   --benchmark <name>           run this workload of the application
+//   --benchmark-output <file>    JSON result, default benchmark_<name>.json
+//   --benchmark-baseline <file>  compare with this earlier result
+//   --benchmark-tolerance <f>    allowed slow-down fraction, default 0.3
+//
+// A workload is the macro commands setting up the application before and
+// after /run/initialize, and its warm-up and timed event counts. Run()
+// times the initialisation, runs the warm-up events (physics tables,
+// caches, first-touch page faults) and then the timed events, counting
+// steps with the count-only QTNMStepMonitor, and writes the timed run's
+// events/s and steps/s, the initialisation time, the QTNMTelemetry thread
+// balance and the peak memory, with the Geant4 version and the seed.
+// Workloads are fixed, so results compare between versions of the code
+// and of Geant4 on the same machine and thread count.
+// With a baseline, Run() fails if the events/s drop or the initialisation
+// time grows by more than the tolerance (plus 0.5 s for the latter). A
+// missing baseline is not recorded: Run() exits with kSkipped, and copying
+// a result file to the baseline records it. The CTest perf tests use this
+// (test/QTNMPerfTests.cmake).
+//
+
+#ifndef QTNMBenchmark_h
+#define QTNMBenchmark_h 1
+
+#include <string>
+#include <vector>
+
+namespace CLI
+{
+  class App;
+}
+
+
+struct QTNMBenchmark
+{
+  struct Workload
+  {
+    std::string              name;
+    std::string              description;
+    std::vector<std::string> preInit;   // before /run/initialize
+    std::vector<std::string> commands;  // after /run/initialize
+    int                      warmup = 0;
+    int                      events = 0;
+  };
+
+  std::vector<Workload> workloads;
+  std::string           name;
+  std::string           output;
+  std::string           baseline;
+  double                tolerance = 0.3;
+
+  // exit code of Run() without a baseline file, CTest's SKIP_RETURN_CODE
+  static constexpr int kSkipped = 77;
+
+  // register the options above, workloads must be set
+  void AddOptions(CLI::App& app);
+
+  bool IsRequested() const { return !name.empty(); }
+
+  // switch on step counting, before the actions are built
+  void Prepare() const;
+
+  // run the selected workload, the exit code for main()
+  int Run(long seed) const;
+
+private:
+  // compare the result file with the baseline, the exit code for Run()
+  int CheckBaseline(const std::string& result, double initTime, double rate,
+                    int threads) const;
+};
+
+
+#endif
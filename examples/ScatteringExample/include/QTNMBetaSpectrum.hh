@@ -0,0 +1,58 @@
+// QTNMBetaSpectrum
+//
+//----------------------------------------------------------------------------
+//
+// Tritium beta-decay electron spectrum, sampled in constant time from a
+// Walker alias table.
+//
+// dN/dE ~ F(Z, E) p (E + m) (Q - E)^2, allowed shape with a massless
+// neutrino and the non-relativistic Fermi function for the He-3 daughter.
+// The table covers an optional kinetic energy window below the endpoint
+// Q with a fixed number of bins, so a window of a few eV below Q gets the
+// full table resolution and every sampled electron falls inside it.
+// The fraction of all decays inside the window is reported when the
+// table is built, to normalise rates.
+//
+
+#ifndef QTNMBetaSpectrum_h
+#define QTNMBetaSpectrum_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+
+class QTNMBetaSpectrum
+{
+public:
+
+  QTNMBetaSpectrum(G4int nBins = 10000);
+  ~QTNMBetaSpectrum() = default;
+
+  // endpoint and window in kinetic energy, emax <= 0 for the endpoint;
+  // the table is rebuilt on change only, true if it was
+  G4bool Configure(G4double endpoint, G4double emin, G4double emax);
+
+  // kinetic energy from two uniforms in [0,1)
+  G4double Sample(G4double u1, G4double u2) const;
+
+  G4double GetWindowFraction() const { return fFraction; }
+
+  // unnormalised spectrum at kinetic energy e
+  G4double Density(G4double e) const;
+
+private:
+  void Build();
+
+  G4int                 fBins;
+  G4double              fEndpoint = -1.;
+  G4double              fEmin     = 0.;
+  G4double              fEmax     = 0.;
+  G4double              fWidth    = 0.;
+  G4double              fFraction = 1.;
+  std::vector<G4double> fProb;
+  std::vector<G4int>    fAlias;
+};
+
+
+#endif
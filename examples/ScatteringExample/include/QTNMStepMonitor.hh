@@ -0,0 +1,102 @@
+// QTNMStepMonitor
+//
+//----------------------------------------------------------------------------
+//
+// Optional stepping action counting steps, track length and sampled wall
+// time per (process, volume, particle), to see where the CPU goes in a
+// geometry. Switched on with --monitor in main(), off it costs nothing.
+//
+// The hot path only uses pointers and integer IDs: the process defining
+// the step gets a slot on first sight, the pre-step logical volume and the
+// particle contribute their instance IDs, and the three form the key of a
+// per-thread table. The time between two consecutive steps of the same
+// track is measured for one step in SetSampling() steps on average and
+// scaled up, so the clock is read rarely; the gaps between timed steps
+// are jittered to avoid locking onto periodic step patterns.
+//
+// As for QTNMStackingAction, the run action calls Flush() on all threads
+// and Report() on the master at the end of a run; names are looked up only
+// then. With SetCountOnly() steps are only counted, as cheaply as a
+// stepping action can, for the steps/s of QTNMBenchmark.
+//
+
+#ifndef QTNMStepMonitor_h
+#define QTNMStepMonitor_h 1
+
+#include "G4UserSteppingAction.hh"
+#include "globals.hh"
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class G4VProcess;
+
+
+class QTNMStepMonitor : public G4UserSteppingAction
+{
+public:
+
+  QTNMStepMonitor();
+  virtual ~QTNMStepMonitor();
+
+  virtual void UserSteppingAction(const G4Step* step);
+
+  // set from main() before the actions are built
+  static void   SetEnabled(G4bool value)   { fgEnabled = value; }
+  static G4bool IsEnabled()                { return fgEnabled; }
+  static void   SetSampling(G4int n)       { fgSampling = (n > 0) ? n : 1; }
+  static void   SetCountOnly(G4bool value) { fgCountOnly = value; }
+
+  // steps of the last reported run
+  static G4double LastSteps();
+
+  // add this thread's table to the run totals
+  static void Flush();
+
+  // print and reset the run totals, master only
+  static void Report();
+
+private:
+  struct Counter
+  {
+    G4double steps  = 0.;
+    G4double length = 0.;
+    G4double time   = 0.;  // seconds, sampled estimate
+  };
+
+  struct Key
+  {
+    const G4VProcess*           process;
+    const G4LogicalVolume*      volume;
+    const G4ParticleDefinition* particle;
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  std::uint64_t ProcessSlot(const G4VProcess* process);
+  static G4int  CurrentEventID();
+
+  static G4bool fgEnabled;
+  static G4int  fgSampling;
+  static G4bool fgCountOnly;
+
+  std::vector<const G4VProcess*>                  fProcesses;  // by slot
+  std::vector<const G4LogicalVolume*>             fVolumes;    // by instance ID
+  std::vector<const G4ParticleDefinition*>        fParticles;  // by ID
+  std::unordered_map<std::uint64_t, Counter>      fTable;
+
+  G4double          fSteps     = 0.;       // count-only mode
+  G4int             fCountdown = 0;
+  std::uint32_t     fJitter    = 2463534242u;  // xorshift state
+  G4int             fSampledTrack = -1;   // timed step: track ID, none if < 0,
+  G4int             fSampledStep  = 0;    // its step number
+  G4int             fSampledEvent = -1;   // and event ID
+  Clock::time_point fStart;
+};
+
+
+#endif
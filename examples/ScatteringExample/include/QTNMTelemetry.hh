@@ -0,0 +1,67 @@
+// QTNMTelemetry
+//
+//----------------------------------------------------------------------------
+//
+// Run progress and throughput without per-event output.
+//
+// Every thread calls EndOfEvent(), which only bumps its own counter; one
+// line is printed at most every SetInterval() seconds, by whichever thread
+// ends an event first after the interval has passed: events done, event
+// rate over the run and since the last report, ETA, event counts of the
+// least and most loaded threads and the peak resident memory. The master
+// brackets the run with BeginOfRun() and EndOfRun(), the latter printing
+// the final numbers, including how long threads idled waiting for the
+// slowest one, and optionally writing them to a JSON summary file for
+// batch systems. LastRun() keeps them for QTNMBenchmark.
+//
+
+#ifndef QTNMTelemetry_h
+#define QTNMTelemetry_h 1
+
+#include "globals.hh"
+
+#include <ostream>
+#include <vector>
+
+
+class QTNMTelemetry
+{
+public:
+
+  // numbers of the last run, set by EndOfRun()
+  struct Summary
+  {
+    G4long                events    = 0;
+    G4double              wallTime  = 0.;   // seconds
+    G4double              rate      = 0.;   // events per second
+    G4int                 threads   = 0;
+    std::vector<G4long>   threadEvents;
+    std::vector<G4double> threadFinish;     // seconds into the run
+    G4double              imbalance = 1.;   // max / mean thread events
+    G4double              tail      = 0.;   // seconds, finish spread
+    G4double              peakRSS   = 0.;   // MB
+  };
+
+  // master, before any event; nEvents to be processed, 0 if unknown
+  static void BeginOfRun(G4long nEvents);
+
+  // any thread, once per event
+  static void EndOfEvent();
+
+  // master, after all workers; summary file name empty or none for none
+  static void EndOfRun(const G4String& summaryFile);
+
+  // seconds between progress lines, 0 for none
+  static void SetInterval(G4double seconds);
+
+  // peak resident set size of the process, in MB
+  static G4double PeakMemory();
+
+  static const Summary& LastRun();
+
+  // the summary fields as JSON members, without braces
+  static void WriteJSON(std::ostream& out, const Summary& run);
+};
+
+
+#endif
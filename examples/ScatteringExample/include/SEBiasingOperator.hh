@@ -0,0 +1,57 @@
+#ifndef SEBiasingOperator_h
+#define SEBiasingOperator_h 1
+
+#include "G4VBiasingOperator.hh"
+#include "G4GenericMessenger.hh"
+#include "globals.hh"
+
+#include <map>
+
+class G4BOptnChangeCrossSection;
+class G4ParticleDefinition;
+
+/// Cross-section biasing operator
+///
+/// Scales the cross-sections of the electron processes wrapped by
+/// G4GenericBiasingPhysics (scattering.cc --biasing) by a common factor
+/// in the volumes it is attached to, the gas. Interactions become more
+/// frequent and tracks carry the compensating statistical weight, which
+/// the sensitive detectors store with each hit.
+///
+/// Commands in /SE/biasing/ are available after /run/initialize.
+
+class SEBiasingOperator : public G4VBiasingOperator
+{
+public:
+  SEBiasingOperator();
+  virtual ~SEBiasingOperator();
+
+  virtual void StartRun();
+
+private:
+  virtual G4VBiasingOperation* ProposeOccurenceBiasingOperation(
+    const G4Track* track, const G4BiasingProcessInterface* callingProcess);
+  virtual G4VBiasingOperation* ProposeFinalStateBiasingOperation(
+    const G4Track*, const G4BiasingProcessInterface*) { return nullptr; }
+  virtual G4VBiasingOperation* ProposeNonPhysicsBiasingOperation(
+    const G4Track*, const G4BiasingProcessInterface*) { return nullptr; }
+
+  using G4VBiasingOperator::OperationApplied;
+  virtual void OperationApplied(const G4BiasingProcessInterface* callingProcess,
+                                G4BiasingAppliedCase biasingCase,
+                                G4VBiasingOperation* occurenceOperationApplied,
+                                G4double weightForOccurenceInteraction,
+                                G4VBiasingOperation* finalStateOperationApplied,
+                                const G4VParticleChange* particleChangeProduced);
+
+  void DefineCommands();
+
+  G4GenericMessenger*                   fMessenger = nullptr;
+  G4double                              fFactor    = 100.;
+  G4bool                                fPrimariesOnly = false;
+  const G4ParticleDefinition*           fParticle  = nullptr;
+
+  std::map<const G4BiasingProcessInterface*, G4BOptnChangeCrossSection*> fOperations;
+};
+
+#endif
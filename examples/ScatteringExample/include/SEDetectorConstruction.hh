@@ -6,10 +6,16 @@
 #include "G4VUserDetectorConstruction.hh"
 #include "globals.hh"
 
+#include <map>
+
 class G4VPhysicalVolume;
+class G4FieldManager;
+class G4UserLimits;
 class G4GlobalMagFieldMessenger;
 class SEGasSD;
 class SEWatchSD;
+class SEFieldTuner;
+class SEBiasingOperator;
 
 class SEDetectorConstruction : public G4VUserDetectorConstruction
 {
@@ -24,7 +30,40 @@ public:
   void     SetGeometry(const G4String& name);
   void     SetDensity(G4double d);
 
+  // per-volume step limits and field accuracy for the selected volume
+  void     SelectVolume(const G4String& name);
+  void     SetMaxStep(G4double value);
+  void     SetMaxTrackLength(G4double value);
+  void     SetMaxTime(G4double value);
+  void     SetMinKinE(G4double value);
+  void     SetVolumeDeltaChord(G4double value);
+  void     SetVolumeDeltaOneStep(G4double value);
+  void     SetVolumeEpsMin(G4double value);
+  void     SetVolumeEpsMax(G4double value);
+
+  // (re)build this thread's volume field managers from the global field
+  void     SetupVolumeFields() const;
+
+  // attach the cross-section biasing operator to the gas, needs the
+  // biased processes wrapped in the physics list (scattering.cc --biasing)
+  void     SetBiasing(G4bool value) { fBiasing = value; }
+
+  const SEFieldTuner* GetFieldTuner() const { return fFieldTuner; }
+
 private:
+  struct VolumeSettings
+  {
+    G4UserLimits* limits       = nullptr;  // owned
+    G4bool        ownField     = false;
+    G4double      deltaChord   = -1.;      // negative: global setting
+    G4double      deltaOneStep = -1.;
+    G4double      epsMin       = -1.;
+    G4double      epsMax       = -1.;
+  };
+
+  VolumeSettings& SelectedVolume();
+  void            ApplyUserLimits() const;
+
   void DefineCommands();
   void DefineMaterials();
 
@@ -33,11 +72,18 @@ private:
   G4VPhysicalVolume* SetupShort();
 
   G4GenericMessenger*                       fDetectorMessenger = nullptr;
+  SEFieldTuner*                             fFieldTuner        = nullptr;
   G4String                                  fGeometryName      = "baseline";
   G4double                                  fdensity;
   G4Cache<G4GlobalMagFieldMessenger*>       fFieldMessenger    = nullptr;
   G4Cache<SEGasSD*>                         fSD1               = nullptr;
   G4Cache<SEWatchSD*>                       fSD2               = nullptr;
+  G4bool                                    fBiasing           = false;
+  G4Cache<SEBiasingOperator*>               fBiasingOperator   = nullptr;
+
+  G4String                                  fSelectedVolume    = "Gas_log";
+  std::map<G4String, VolumeSettings>        fVolumeSettings;
+  G4Cache<std::map<G4String, G4FieldManager*>> fVolumeFields;
 };
 
 #endif
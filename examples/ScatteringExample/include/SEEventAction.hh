@@ -4,21 +4,30 @@
 #include "SEGasHit.hh"
 #include "SEWatchHit.hh"
 
+#include "G4Accumulable.hh"
 #include "G4UserEventAction.hh"
 #include "globals.hh"
 
+class SERadiationSignal;
+
 /// Event action class
 ///
 
 class SEEventAction : public G4UserEventAction
 {
 public:
-  SEEventAction()          = default;
-  virtual ~SEEventAction() = default;
+  SEEventAction(SERadiationSignal* signal = nullptr);
+  virtual ~SEEventAction();
 
   virtual void BeginOfEventAction(const G4Event* event);
   virtual void EndOfEventAction(const G4Event* event);
 
+  // weighted gas energy deposit per event, its mean does not depend on
+  // the biasing; merged over threads with the run's accumulables
+  G4int    GetEdepEvents() const { return fEdepEvents.GetValue(); }
+  G4double GetEdepSum()    const { return fEdepSum.GetValue(); }
+  G4double GetEdepSum2()   const { return fEdepSum2.GetValue(); }
+
 private:
   // methods
   SEGasHitsCollection*     GetGasHitsCollection(G4int hcID,
@@ -32,6 +41,13 @@ private:
   G4int                 fGID    = -1;
   G4int                 fWID    = -1;
 
+  G4Accumulable<G4int>    fEdepEvents = 0;
+  G4Accumulable<G4double> fEdepSum    = 0.;
+  G4Accumulable<G4double> fEdepSum2   = 0.;
+
+  // radiation signal, owned, worker threads only
+  SERadiationSignal*    fSignal = nullptr;
+
 };
 
 #endif
@@ -0,0 +1,75 @@
+#ifndef SEFieldTuner_h
+#define SEFieldTuner_h 1
+
+#include "G4GenericMessenger.hh"
+#include "globals.hh"
+
+class G4FieldManager;
+
+/// Field propagation accuracy parameters and their calibration
+///
+/// Holds the chord finder and integration accuracy parameters
+/// (DeltaChord, DeltaOneStep, DeltaIntersection, epsilon min/max) and
+/// applies them to a field manager at the start of each run.
+///
+/// /SE/field/tune propagates an electron through a uniform field with
+/// a stand-alone chord finder for a range of settings, in steps of a
+/// requested length as left by physics and user limits, compares with the
+/// analytic helix and keeps the cheapest settings for which the kinetic
+/// energy and gyro-phase errors stay inside the tolerances, by the median
+/// time of repeated propagations. The result is written as a macro of
+/// /SE/field/ commands for production runs.
+
+class SEFieldTuner
+{
+public:
+  SEFieldTuner();
+  ~SEFieldTuner();
+
+  void Apply(G4FieldManager* fieldManager) const;
+  void Tune();
+
+private:
+  struct Settings
+  {
+    G4double deltaChord;
+    G4double deltaOneStep;
+    G4double epsMin;
+    G4double epsMax;
+  };
+
+  struct Outcome
+  {
+    G4double energyError;  // relative
+    G4double phaseError;   // [rad]
+    G4long   nSteps;
+    G4double seconds;      // median of the repetitions
+  };
+
+  Outcome Benchmark(const Settings& settings) const;
+  void    WriteMacro(const Settings& settings, const Outcome& outcome) const;
+  void    DefineCommands();
+
+  G4GenericMessenger* fMessenger      = nullptr;
+  G4GenericMessenger* fTuneMessenger  = nullptr;
+
+  // propagation parameters, Geant4 defaults
+  G4double fDeltaChord;
+  G4double fDeltaOneStep;
+  G4double fDeltaIntersection;
+  G4double fEpsMin = 5.e-5;
+  G4double fEpsMax = 1.e-3;
+
+  // calibration benchmark and tolerances
+  G4double fTuneField       = 1.;       // [T] along z
+  G4double fTuneEnergy      = 18.575;   // [keV]
+  G4double fTunePitch       = 88.;      // [deg]
+  G4int    fTuneTurns       = 1000;
+  G4double fTuneStep        = 1.;       // [mm] requested per step
+  G4int    fTuneRepeats     = 5;
+  G4double fEnergyTolerance = 1.e-6;    // relative
+  G4double fPhaseTolerance  = 0.1;      // [rad] after all turns
+  G4String fMacroName       = "fieldSettings.mac";
+};
+
+#endif
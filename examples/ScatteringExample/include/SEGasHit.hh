@@ -8,7 +8,9 @@
 /// Gas hit class
 ///
 /// It defines data members to store the energy deposit,
-/// and position in a selected volume:
+/// and position in a selected volume, the index of the
+/// primary the track descends from and its statistical weight,
+/// not 1 with cross-section biasing:
 
 class SEGasHit : public G4VHit
 {
@@ -34,6 +36,8 @@ class SEGasHit : public G4VHit
     void SetEdep     (G4double de)  { fEdep = de; };
     void SetTime     (G4double ti)  { fTime = ti; };
     void SetKine     (G4double ke)  { fKine = ke; };
+    void SetPrimary  (G4int ip)     { fPrimary = ip; };
+    void SetWeight   (G4double w)   { fWeight = w; };
 
     // Get methods
     G4int    GetParentID() const { return fPid; };
@@ -41,6 +45,8 @@ class SEGasHit : public G4VHit
     G4double GetEdep() const     { return fEdep; };
     G4double GetTime() const     { return fTime; };
     G4double GetKine() const     { return fKine; };
+    G4int    GetPrimary() const  { return fPrimary; };
+    G4double GetWeight() const   { return fWeight; };
 
   private:
 
@@ -49,6 +55,8 @@ class SEGasHit : public G4VHit
       G4double      fEdep;
       G4double      fTime;
       G4double      fKine;
+      G4int         fPrimary;
+      G4double      fWeight;
 };
 
 typedef G4THitsCollection<SEGasHit> SEGasHitsCollection;
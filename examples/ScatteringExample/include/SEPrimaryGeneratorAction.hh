@@ -2,16 +2,30 @@
 #define SEPrimaryGeneratorAction_h 1
 
 #include "G4VUserPrimaryGeneratorAction.hh"
+#include "G4GenericMessenger.hh"
+#include "G4ThreeVector.hh"
 #include "globals.hh"
+#include "QTNMBetaSpectrum.hh"
 
 class G4ParticleGun;
 class G4Event;
+class QTNMPhaseSpaceReader;
 
 
 /// Primary generator
 ///
 /// A single particle is generated.
 /// macro commands can change primary properties.
+/// The source position depends on the world size, looked up
+/// once per run with UpdateGeometry().
+/// /SE/generator/primaries shoots several independent primaries per
+/// event to share the per-event overhead, see SETrackInformation.
+/// With /SE/generator/spectrum beta the electron energy follows the
+/// tritium beta spectrum, optionally restricted to a window below the
+/// endpoint, see QTNMBetaSpectrum.
+/// With /SE/generator/phaseSpace the primaries are read from a phase-space
+/// file written by a source simulation instead, record i for virtual
+/// event i, so each thread reads the records of its own events.
 
 class SEPrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
@@ -21,9 +35,37 @@ public:
 
   virtual void GeneratePrimaries(G4Event*);
 
+  // refresh geometry-derived source parameters, at run start
+  void UpdateGeometry();
+
+  G4int GetPrimariesPerEvent() const { return fNPrimaries; }
+
 private:
 
+  void DefineCommands();
+  void GeneratePhaseSpace(G4Event* event, std::size_t index);
+
   G4ParticleGun*      fParticleGun;
+  G4GenericMessenger* fMessenger     = nullptr;
+  G4ThreeVector       fSourcePos;
+  G4bool              fGeometryValid = false;
+  G4int               fNPrimaries    = 1;
+
+  // energy spectrum, mono-energetic gun or tritium beta decay
+  G4String            fSpectrum      = "mono";
+  G4double            fEndpoint;
+  G4double            fWindowMin     = 0.;
+  G4double            fWindowMax     = 0.;     // 0 for the endpoint
+  QTNMBetaSpectrum    fBeta;
+
+  // phase-space input
+  G4String              fPhaseSpace    = "none";
+  G4int                 fPDG           = 0;      // 0 for all particles
+  G4bool                fKeepPosition  = false;
+  QTNMPhaseSpaceReader* fReader        = nullptr;
+  G4int                 fReaderPDG     = 0;
+  G4ParticleGun*        fPhaseSpaceGun = nullptr;  // keeps the gun settings for phaseSpace none
+  G4bool                fRecycled      = false;
 
 };
 
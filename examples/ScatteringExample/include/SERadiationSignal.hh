@@ -0,0 +1,72 @@
+#ifndef SERadiationSignal_h
+#define SERadiationSignal_h 1
+
+#include "G4GenericMessenger.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <complex>
+#include <vector>
+
+class G4Step;
+
+/// Streaming cyclotron radiation signal
+///
+/// Accumulates the far-field (Lienard-Wiechert) electric field of all
+/// charged tracks at a single antenna point, step by step, without storing
+/// the trajectory. The field component along the antenna polarisation is
+/// down-mixed with a local oscillator and integrated into fixed-width
+/// output bins (integrate-and-dump decimation), so the memory per thread
+/// is bounded by the number of output samples per primary. With several primaries per
+/// event, each primary and its secondaries have their own bins, written
+/// under the virtual event ID like the hits.
+///
+/// The time resolution is limited by the step length: steps should be
+/// short compared to the cyclotron period, see /SE/detector/ step limits.
+/// Commands in /SE/signal/ are available after /run/initialize.
+/// Steps outside the output window are counted per thread; the run
+/// action calls Flush() on all threads and Report() on the master.
+
+class SERadiationSignal
+{
+public:
+  SERadiationSignal();
+  ~SERadiationSignal();
+
+  void BeginOfEvent();
+  void AddStep(const G4Step* step);
+  void EndOfEvent(G4int eventID);
+
+  G4bool IsActive() const { return fActive; }
+
+  // add this thread's out-of-window count to the run total
+  static void Flush();
+
+  // print and reset the run total, master only
+  static void Report();
+
+private:
+  void DefineCommands();
+
+  G4GenericMessenger*               fMessenger = nullptr;
+
+  // configuration
+  G4bool                            fActive      = false;
+  G4ThreeVector                     fAntennaPos;     // antenna location
+  G4ThreeVector                     fPolarisation;   // antenna polarisation
+  G4double                          fLOFrequency = 26.5;   // [GHz]
+  G4double                          fSampleRate  = 1000.;  // [MHz], after decimation
+  G4int                             fNSamples    = 8192;   // bins per event
+  G4double                          fWindowStart = 0.;     // observer time of first bin
+
+  // per-event state
+  std::vector<std::vector<std::complex<G4double>>> fSamples;  // per primary
+  G4ThreeVector                     fPolUnit;
+  G4double                          fOmegaLO     = 0.;
+  G4double                          fBinWidth    = 0.;
+  G4int                             fUndersampled = 0;
+  G4long                            fOutOfWindow  = 0;  // since last Flush()
+  G4bool                            fWarned       = false;
+};
+
+#endif
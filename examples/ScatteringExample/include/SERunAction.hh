@@ -1,10 +1,13 @@
 #ifndef SERunAction_h
 #define SERunAction_h 1
 
+#include "G4Accumulable.hh"
+#include "G4GenericMessenger.hh"
 #include "G4UserRunAction.hh"
 #include "globals.hh"
 
 class SEEventAction;
+class SEPrimaryGeneratorAction;
 class G4Run;
 
 /// Run action class
@@ -13,15 +16,31 @@ class G4Run;
 class SERunAction : public G4UserRunAction
 {
 public:
-  SERunAction(SEEventAction* eventAction, G4String name);
+  SERunAction(SEEventAction* eventAction, G4String name,
+              SEPrimaryGeneratorAction* primary = nullptr);
   virtual ~SERunAction();
 
   virtual void BeginOfRunAction(const G4Run*);
   virtual void EndOfRunAction(const G4Run*);
 
+  // observation time window, zero for none
+  G4double GetTimeWindow() const { return fTimeWindow; }
+  void     AddTimeCut(G4double stepsSaved, G4double timeSaved);
+
 private:
+  void DefineCommands();
+
   SEEventAction*   fEventAction;  // have event information for run
   G4String         fout;          // output file name
+  SEPrimaryGeneratorAction* fPrimary;  // worker threads only
+
+  G4GenericMessenger*      fMessenger  = nullptr;
+  G4double                 fTimeWindow = 0.;
+  G4double                 fProgress   = 10.;     // seconds between progress lines
+  G4String                 fSummary    = "none";  // JSON run summary file
+  G4Accumulable<G4int>     fKilled     = 0;
+  G4Accumulable<G4double>  fStepsSaved = 0.;
+  G4Accumulable<G4double>  fTimeSaved  = 0.;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
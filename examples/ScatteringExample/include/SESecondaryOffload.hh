@@ -0,0 +1,83 @@
+#ifndef SESecondaryOffload_h
+#define SESecondaryOffload_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+class G4ParticleDefinition;
+class G4Track;
+
+/// Secondary offload
+///
+/// Shares the tracking of one long event between threads. Secondaries
+/// created in the offload volume (/SE/offload/, see SEStackingAction) are
+/// queued for worker threads whose event loop has ended, numbered per event
+/// as sub-events 1, 2, ... A secondary is only queued while an idle worker
+/// waits for it, so the queue never holds more secondaries than there are
+/// idle workers; otherwise it is stacked as usual. Idle workers track
+/// queued secondaries, each as a separate Geant4 event with the ID of the
+/// event it came from, until the queue is empty and no thread can add to
+/// it, so threads no longer stand idle while the last long event finishes.
+/// Every sub-event is seeded from (seed, run, event, sub-event), hence it
+/// does not depend on which thread tracks it; which secondaries become
+/// sub-events depends on timing, though. Needs the MT run
+/// manager; with the serial and tasking run managers nothing is queued.
+
+class SESecondaryOffload
+{
+public:
+
+  // queued secondary
+  struct Item
+  {
+    G4int                       eventID  = 0;
+    G4int                       subEvent = 0;
+    G4int                       primary  = 0;
+    G4int                       thread   = 0;
+    const G4ParticleDefinition* particle = nullptr;
+    G4double                    energy   = 0.;
+    G4ThreeVector               position;
+    G4ThreeVector               direction;
+    G4double                    time     = 0.;
+    G4double                    weight   = 1.;
+  };
+
+  // a worker thread joins the run, before its first event
+  static void BeginOfRun();
+
+  // new event on this thread, restarts the sub-event numbering
+  static void BeginOfEvent();
+
+  // queue a new secondary for an idle worker, false if none is free and
+  // it must be stacked as usual
+  static G4bool Offload(const G4Track* track);
+
+  // leave the run: track queued secondaries until no thread can add more
+  static void EndOfRun();
+
+  // tracking a queued secondary on this thread
+  static G4bool InSubEvent();
+
+  // sub-event number, 0 outside sub-events
+  static G4int  SubEvent();
+
+  // primary index of the track a sub-event was created by
+  static G4int  Primary();
+
+  // primary of an ordinary event, not the first track of a sub-event
+  static G4bool IsPrimary(const G4Track* track);
+
+  // add the value of an event or of one of its sub-events, at their end;
+  // true with the event total once the event and all its sub-events ended,
+  // on whichever thread that is
+  static G4bool Collect(G4int eventID, G4double value, G4double& total);
+
+  // print and reset the run totals, master only
+  static void Report();
+
+private:
+
+  static void Track(const Item& item);
+};
+
+#endif
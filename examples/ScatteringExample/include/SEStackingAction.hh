@@ -0,0 +1,34 @@
+#ifndef SEStackingAction_h
+#define SEStackingAction_h 1
+
+#include "QTNMStackingAction.hh"
+#include "G4GenericMessenger.hh"
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+/// Stacking action class
+///
+/// Secondaries pass the /SE/stack/ rules first. With /SE/offload/enable
+/// those created in the offload volume (default Gas_log) above
+/// /SE/offload/minEnergy are then handed to SESecondaryOffload, to be
+/// tracked by another thread, instead of being stacked.
+
+class SEStackingAction : public QTNMStackingAction
+{
+public:
+  SEStackingAction();
+  virtual ~SEStackingAction();
+
+  virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track);
+  virtual void PrepareNewEvent();
+
+private:
+  void DefineCommands();
+
+  G4GenericMessenger* fMessenger = nullptr;
+  G4bool              fOffload   = false;
+  G4String            fVolume    = "Gas_log";
+  G4double            fMinEnergy = 1. * CLHEP::keV;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef SESteppingAction_h
+#define SESteppingAction_h 1
+
+#include "G4UserSteppingAction.hh"
+#include "globals.hh"
+
+class SERadiationSignal;
+class SERunAction;
+class SETrapMonitor;
+
+/// Stepping action class
+///
+/// Forwards every step to the radiation signal accumulator
+/// and the trapped electron detection; kills tracks leaving
+/// the observation time window.
+
+class SESteppingAction : public G4UserSteppingAction
+{
+public:
+  SESteppingAction(SERadiationSignal* signal, SERunAction* runAction);
+  virtual ~SESteppingAction();
+
+  virtual void UserSteppingAction(const G4Step* step);
+
+private:
+  SERadiationSignal* fSignal = nullptr;
+  SETrapMonitor*     fTrap   = nullptr;  // owned
+  SERunAction*       fRunAction = nullptr;
+
+  // completed tracks, to estimate the work saved by the time window
+  G4double           fTracks   = 0.;
+  G4double           fSteps    = 0.;
+  G4double           fDuration = 0.;
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef SETrackInformation_h
+#define SETrackInformation_h 1
+
+#include "G4VUserTrackInformation.hh"
+#include "G4Allocator.hh"
+#include "globals.hh"
+
+class G4Track;
+
+/// Track information class
+///
+/// Index of the primary a track descends from, for events with several
+/// independent primaries (/SE/generator/primaries). Attached to primaries
+/// by SETrackingAction and handed on to their secondaries; tracks without
+/// information belong to primary 0.
+
+class SETrackInformation : public G4VUserTrackInformation
+{
+  public:
+    SETrackInformation(G4int primary) : fPrimary(primary) {};
+    virtual ~SETrackInformation() = default;
+
+    inline void* operator new(size_t);
+    inline void  operator delete(void*);
+
+    G4int GetPrimary() const { return fPrimary; };
+
+    // primary index of any track, 0 without information
+    static G4int GetPrimary(const G4Track* track);
+
+    // virtual event ID of a primary in the current event
+    static G4int VirtualEventID(G4int eventID, G4int primary);
+
+  private:
+
+      G4int         fPrimary;
+};
+
+extern G4ThreadLocal G4Allocator<SETrackInformation>* SETrackInformationAllocator;
+
+inline void* SETrackInformation::operator new(size_t)
+{
+  if(!SETrackInformationAllocator)
+      SETrackInformationAllocator = new G4Allocator<SETrackInformation>;
+  return (void *) SETrackInformationAllocator->MallocSingle();
+}
+
+inline void SETrackInformation::operator delete(void *info)
+{
+  SETrackInformationAllocator->FreeSingle((SETrackInformation*) info);
+}
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef SETrackingAction_h
+#define SETrackingAction_h 1
+
+#include "G4UserTrackingAction.hh"
+#include "globals.hh"
+
+class SEPrimaryGeneratorAction;
+
+/// Tracking action class
+///
+/// With several primaries per event, labels each primary with its index
+/// (track ID - 1) and passes the label on to the secondaries, see
+/// SETrackInformation. Nothing is attached for one primary per event.
+
+class SETrackingAction : public G4UserTrackingAction
+{
+public:
+  SETrackingAction(SEPrimaryGeneratorAction* primary);
+  virtual ~SETrackingAction() = default;
+
+  virtual void PreUserTrackingAction(const G4Track* track);
+  virtual void PostUserTrackingAction(const G4Track* track);
+
+private:
+  SEPrimaryGeneratorAction* fPrimary = nullptr;
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef SETrapMonitor_h
+#define SETrapMonitor_h 1
+
+#include "G4GenericMessenger.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+class G4Step;
+class G4Track;
+
+/// Trapped electron detection
+///
+/// Counts the axial turning points of a charged track, i.e. sign changes
+/// of the momentum component along the local magnetic field. After the
+/// configured number of bounces the track is taken as trapped: its pitch
+/// angle at the vertex and the axial period are written to the 'Trap'
+/// ntuple and the track is killed, or only flagged and tracked on.
+/// Tracks ending untrapped are recorded too, for trapping fractions.
+/// Commands in /SE/trap/ are available after /run/initialize.
+
+class SETrapMonitor
+{
+public:
+  SETrapMonitor();
+  ~SETrapMonitor();
+
+  void   ProcessStep(const G4Step* step);
+  G4bool IsActive() const { return fActive; }
+
+private:
+  G4ThreeVector FieldAt(const G4Step* step, const G4ThreeVector& pos,
+                        G4double time) const;
+  void          Record(const G4Track* track, G4bool trapped);
+  void          SetAction(const G4String& action);
+  void          DefineCommands();
+
+  G4GenericMessenger* fMessenger     = nullptr;
+
+  // configuration
+  G4bool   fActive        = false;
+  G4int    fBounces       = 4;
+  G4bool   fKill          = true;
+  G4bool   fPrimariesOnly = true;
+
+  // state of the current track
+  G4int    fSign      = 0;
+  G4double fLastPar   = 0.;
+  G4int    fCount     = 0;
+  G4double fFirstTime = 0.;
+  G4double fLastTime  = 0.;
+  G4bool   fTrapped   = false;
+};
+
+#endif
@@ -9,7 +9,9 @@
 /// Stop Watch hit class
 ///
 /// It defines data members to store the track ID, Time
-/// and position on crossing the stop watch boundary:
+/// and position on crossing the stop watch boundary, the
+/// index of the primary the track descends from and its
+/// statistical weight:
 
 class SEWatchHit : public G4VHit
 {
@@ -33,17 +35,23 @@ class SEWatchHit : public G4VHit
     void SetHid      (G4int    id)      { fHid  = id; };
     void SetTime     (G4double ti)      { fTime = ti; };
     void SetPos      (G4ThreeVector xyz){ fPos = xyz; };
+    void SetPrimary  (G4int    ip)      { fPrimary = ip; };
+    void SetWeight   (G4double w)       { fWeight = w; };
 
     // Get methods
     G4int    GetHID() const      { return fHid; };
     G4double GetTime() const     { return fTime; };
     G4ThreeVector GetPos() const { return fPos; };
+    G4int    GetPrimary() const  { return fPrimary; };
+    G4double GetWeight() const   { return fWeight; };
 
   private:
 
       G4int         fHid;
       G4double      fTime;
       G4ThreeVector fPos;
+      G4int         fPrimary;
+      G4double      fWeight;
 };
 
 typedef G4THitsCollection<SEWatchHit> SEWatchHitsCollection;
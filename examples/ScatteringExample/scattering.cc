@@ -17,6 +17,7 @@
 #include "G4RunManagerFactory.hh"
 #include "G4UImanager.hh"
 #include "G4Threading.hh"
+#include "G4GenericBiasingPhysics.hh"
 #include "G4GenericPhysicsList.hh"
 #include "G4VModularPhysicsList.hh"
 
@@ -24,46 +25,70 @@
 #include "CLI11.hpp"  // c++17 safe; https://github.com/CLIUtils/CLI11
 #include "SEActionInitialization.hh"
 #include "SEDetectorConstruction.hh"
+#include "QTNMBenchmark.hh"
+#include "QTNMEventSeeding.hh"
+#include "QTNMRunManager.hh"
+#include "QTNMStepMonitor.hh"
 
 int main(int argc, char** argv)
 {
   // command line interface
   CLI::App    app{ "Scattering example for QTNM" };
-  int         nthreads = 4;
   std::string outputFileName("qtnm.root");
   std::string macroName;
+  int         monitor  = 0;
   std::string physListMacro;
+  bool        biasing = false;
 
   app.add_option("-m,--macro", macroName, "<Geant4 macro filename> Default: None");
   app.add_option("-p,--physlist", physListMacro, "<Geant4 physics list macro> Default: QTNMPhysicsList");
   app.add_option("-o,--outputFile", outputFileName,
                  "<FULL PATH ROOT FILENAME> Default: qtnm.root");
-  app.add_option("-t, --nthreads", nthreads, "<number of threads to use> Default: 4");
+  QTNMRunManager runOptions;  // run manager type, threads and event batching
+  runOptions.AddOptions(app);
+  QTNMEventSeeding seeding;   // seed and event range of this process
+  seeding.AddOptions(app);
+  QTNMBenchmark benchmark;    // reference workloads instead of a macro
+  benchmark.workloads = {
+    { "uniform-field", "baseline geometry, 1 T axial field, 18.575 keV electrons, 200 ns window",
+      { "/SE/detector/setGeometry baseline" },
+      { "/run/verbose 0", "/tracking/verbose 0", "/SE/run/progress 0",
+        "/globalField/setValue 0 0 1 tesla", "/SE/run/timeWindow 200 ns" },
+      10, 100 },
+    { "bunches", "gas bunches geometry, no field, 18.575 keV electrons",
+      { "/SE/detector/setGeometry bunches" },
+      { "/run/verbose 0", "/tracking/verbose 0", "/SE/run/progress 0" },
+      20, 200 } };
+  benchmark.AddOptions(app);
+  app.add_option("--monitor", monitor,
+                 "<n> Step statistics per process and volume, timing 1 in n steps. Default: 0, off");
+  app.add_flag("-b,--biasing", biasing,
+               "Bias e- ionisation and Coulomb scattering in the gas, see /SE/biasing/");
 
   CLI11_PARSE(app, argc, argv);
 
+  // optional step statistics, set before the actions are built
+  QTNMStepMonitor::SetEnabled(monitor > 0);
+  QTNMStepMonitor::SetSampling(monitor);
+  benchmark.Prepare();  // counts steps unless monitored anyway
+
   // GEANT4 code
   // Get the pointer to the User Interface manager
   //
   G4UImanager* UImanager = G4UImanager::GetUIpointer();
 
   // Don't accept interactive mode (no macroName).
-  if(macroName.empty())
+  if(macroName.empty() && !benchmark.IsRequested())
   {
     G4cout << "No interactive mode running of example: provide a macro!" << G4endl;
     return 1;
   }
 
-  // -- Construct the run manager : MT or sequential one
-  auto* runManager = G4RunManagerFactory::CreateRunManager();
-#ifdef G4MULTITHREADED
-  nthreads =
-    std::min(nthreads, G4Threading::G4GetNumberOfCores());  // limit thread number to
-                                                            // max on machine
-  G4cout << "      ********* Run Manager constructed in MT mode: " << nthreads
-         << " threads ***** " << G4endl;
-  runManager->SetNumberOfThreads(nthreads);
-#endif
+  // seed from the command line, per event from (seed, run, global event ID)
+  seeding.Apply();
+
+  // -- Construct the run manager : serial, MT or tasking
+  auto* runManager = runOptions.Create();
 
 
   // -- Set mandatory initialization classes
@@ -85,10 +110,20 @@ int main(int argc, char** argv)
     std::vector<G4String>* myConstructors = new std::vector<G4String>;
 
     myConstructors->push_back("QTNMPhysicsList");
+    myConstructors->push_back("G4StepLimiterPhysics");  // /SE/detector/ limits
 
     physList = new G4GenericPhysicsList(myConstructors);
   }
 
+  // wrap the biased processes, the operator is attached by the detector
+  if(biasing)
+  {
+    auto biasingPhysics = new G4GenericBiasingPhysics();
+    biasingPhysics->PhysicsBias("e-", { "eIoni", "CoulombScat" });
+    physList->RegisterPhysics(biasingPhysics);
+    detector->SetBiasing(true);
+  }
+
   // finish physics list
   runManager->SetUserInitialization(physList);
 
@@ -98,9 +133,21 @@ int main(int argc, char** argv)
   runManager->SetUserInitialization(actions);
 
 
+  // reference workload instead of the macro
+  if(benchmark.IsRequested())
+  {
+    int status = benchmark.Run(seeding.Seed());
+    delete runManager;
+    return status;
+  }
+
   // Batch mode only - no visualisation
   G4String command = "/control/execute ";
   UImanager->ApplyCommand(command + macroName);
+
+  // a range of a split production, the macro only configures
+  if(seeding.nEvents > 0)
+    UImanager->ApplyCommand("/run/beamOn " + std::to_string(seeding.nEvents));
   
   delete runManager;
   return 0;
@@ -0,0 +1,208 @@
+// QTNMPhaseSpace
+//
+//----------------------------------------------------------------------------
+//
+
+#include "QTNMPhaseSpace.hh"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "G4AutoLock.hh"
+#include "G4Threading.hh"
+#include "G4ios.hh"
+
+
+namespace
+{
+  const char          kMagic[8]   = { 'Q', 'T', 'N', 'M', 'P', 'H', 'S', 'P' };
+  const std::uint32_t kVersion    = 1;
+  const std::size_t   kBufferSize = 4096;  // records per thread between flushes
+
+  // shared output file, guarded by the mutex while workers append
+  G4Mutex       phaseSpaceMutex = G4MUTEX_INITIALIZER;
+  std::FILE*    outFile  = nullptr;
+  std::uint64_t outCount = 0;
+
+  // set with the file under the mutex; fixed during the event loop, so
+  // threads read it every event without taking the lock
+  std::atomic<bool> outOpen(false);
+
+  G4ThreadLocal std::vector<QTNMPhaseSpaceRecord>* outBuffer = nullptr;
+}
+
+// QTNMPhaseSpaceWriter
+
+G4bool QTNMPhaseSpaceWriter::Open(const G4String& name)
+{
+  G4AutoLock lock(&phaseSpaceMutex);
+  if(outFile)
+  {
+    G4Exception("QTNMPhaseSpaceWriter::Open()", "QTNM0001", JustWarning,
+                "Phase-space file already open, records go to the open file.");
+    return false;
+  }
+
+  outFile = std::fopen(name.c_str(), "wb");
+  if(!outFile)
+  {
+    G4ExceptionDescription msg;
+    msg << "Cannot open phase-space file " << name << " for writing.";
+    G4Exception("QTNMPhaseSpaceWriter::Open()", "QTNM0001", JustWarning, msg);
+    return false;
+  }
+
+  // count is filled in on Close()
+  QTNMPhaseSpaceHeader header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version    = kVersion;
+  header.recordSize = sizeof(QTNMPhaseSpaceRecord);
+  header.count      = 0;
+  std::fwrite(&header, sizeof(header), 1, outFile);
+  outCount = 0;
+  outOpen.store(true, std::memory_order_release);
+  return true;
+}
+
+void QTNMPhaseSpaceWriter::Close()
+{
+  G4AutoLock lock(&phaseSpaceMutex);
+  if(!outFile) return;
+
+  QTNMPhaseSpaceHeader header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version    = kVersion;
+  header.recordSize = sizeof(QTNMPhaseSpaceRecord);
+  header.count      = outCount;
+  std::fseek(outFile, 0, SEEK_SET);
+  std::fwrite(&header, sizeof(header), 1, outFile);
+  std::fclose(outFile);
+  outFile = nullptr;
+  outOpen.store(false, std::memory_order_release);
+
+  G4cout << ">>> Phase space: " << outCount << " records written." << G4endl;
+}
+
+G4bool QTNMPhaseSpaceWriter::IsOpen()
+{
+  return outOpen.load(std::memory_order_acquire);
+}
+
+void QTNMPhaseSpaceWriter::Write(const QTNMPhaseSpaceRecord& record)
+{
+  if(!outBuffer)
+  {
+    outBuffer = new std::vector<QTNMPhaseSpaceRecord>;
+    outBuffer->reserve(kBufferSize);
+  }
+  outBuffer->push_back(record);
+}
+
+void QTNMPhaseSpaceWriter::EndOfEvent()
+{
+  if(outBuffer && outBuffer->size() >= kBufferSize) Flush();
+}
+
+void QTNMPhaseSpaceWriter::Flush()
+{
+  if(!outBuffer || outBuffer->empty()) return;
+
+  G4AutoLock lock(&phaseSpaceMutex);
+  if(outFile)
+  {
+    outCount += std::fwrite(outBuffer->data(), sizeof(QTNMPhaseSpaceRecord),
+                            outBuffer->size(), outFile);
+  }
+  outBuffer->clear();
+}
+
+// QTNMPhaseSpaceReader
+
+QTNMPhaseSpaceReader::QTNMPhaseSpaceReader(const G4String& name)
+  : fName(name)
+{
+  fFile = ::open(name.c_str(), O_RDONLY);
+  struct stat info;
+  if(fFile < 0 || ::fstat(fFile, &info) != 0
+     || (std::size_t) info.st_size < sizeof(QTNMPhaseSpaceHeader))
+  {
+    G4ExceptionDescription msg;
+    msg << "Cannot read phase-space file " << name << ".";
+    G4Exception("QTNMPhaseSpaceReader::QTNMPhaseSpaceReader()", "QTNM0002",
+                FatalException, msg);
+    return;
+  }
+
+  fMapSize = info.st_size;
+  fMap     = ::mmap(nullptr, fMapSize, PROT_READ, MAP_PRIVATE, fFile, 0);
+  if(fMap == MAP_FAILED)
+  {
+    fMap = nullptr;
+    G4ExceptionDescription msg;
+    msg << "Cannot map phase-space file " << name << ".";
+    G4Exception("QTNMPhaseSpaceReader::QTNMPhaseSpaceReader()", "QTNM0002",
+                FatalException, msg);
+    return;
+  }
+  ::posix_madvise(fMap, fMapSize, POSIX_MADV_SEQUENTIAL);
+
+  auto header = static_cast<const QTNMPhaseSpaceHeader*>(fMap);
+  if(std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0
+     || header->version != kVersion
+     || header->recordSize != sizeof(QTNMPhaseSpaceRecord))
+  {
+    G4ExceptionDescription msg;
+    msg << name << " is not a version " << kVersion << " phase-space file.";
+    G4Exception("QTNMPhaseSpaceReader::QTNMPhaseSpaceReader()", "QTNM0002",
+                FatalException, msg);
+    return;
+  }
+
+  // an unclosed file has no count, trust the file size instead
+  fRecords = reinterpret_cast<const QTNMPhaseSpaceRecord*>(
+               static_cast<const char*>(fMap) + sizeof(QTNMPhaseSpaceHeader));
+  std::size_t available = (fMapSize - sizeof(QTNMPhaseSpaceHeader))
+                          / sizeof(QTNMPhaseSpaceRecord);
+  fCount = header->count;
+  if(fCount != available)
+  {
+    G4ExceptionDescription msg;
+    msg << name << " holds " << available << " records, header says "
+        << fCount << "; reading " << available << ".";
+    G4Exception("QTNMPhaseSpaceReader::QTNMPhaseSpaceReader()", "QTNM0003",
+                JustWarning, msg);
+    fCount = available;
+  }
+}
+
+QTNMPhaseSpaceReader::~QTNMPhaseSpaceReader()
+{
+  if(fMap) ::munmap(fMap, fMapSize);
+  if(fFile >= 0) ::close(fFile);
+}
+
+void QTNMPhaseSpaceReader::SetPDG(G4int pdg)
+{
+  fPDG = pdg;
+  fSelected.clear();
+  if(fPDG == 0) return;
+
+  for(std::size_t i = 0; i < fCount; ++i)
+    if(fRecords[i].pdg == fPDG) fSelected.push_back(i);
+}
+
+std::size_t QTNMPhaseSpaceReader::GetEntries() const
+{
+  return (fPDG == 0) ? fCount : fSelected.size();
+}
+
+const QTNMPhaseSpaceRecord& QTNMPhaseSpaceReader::GetRecord(std::size_t i) const
+{
+  return (fPDG == 0) ? fRecords[i] : fRecords[fSelected[i]];
+}
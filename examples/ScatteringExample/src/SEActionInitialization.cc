@@ -1,7 +1,14 @@
 #include "SEActionInitialization.hh"
 #include "SEEventAction.hh"
 #include "SEPrimaryGeneratorAction.hh"
+#include "SERadiationSignal.hh"
 #include "SERunAction.hh"
+#include "SEStackingAction.hh"
+#include "SESteppingAction.hh"
+#include "SETrackingAction.hh"
+#include "QTNMStepMonitor.hh"
+
+#include "G4MultiSteppingAction.hh"
 
 
 SEActionInitialization::SEActionInitialization(G4String name)
@@ -20,8 +27,24 @@ void SEActionInitialization::BuildForMaster() const
 void SEActionInitialization::Build() const
 {
   // forward detector
-  SetUserAction(new SEPrimaryGeneratorAction());
-  auto event = new SEEventAction;
+  auto primary = new SEPrimaryGeneratorAction();
+  SetUserAction(primary);
+  auto signal = new SERadiationSignal;  // owned by event action
+  auto event  = new SEEventAction(signal);
   SetUserAction(event);
-  SetUserAction(new SERunAction(event, foutname));
+  auto run    = new SERunAction(event, foutname, primary);
+  SetUserAction(run);
+  auto stepping = new SESteppingAction(signal, run);
+  if(QTNMStepMonitor::IsEnabled())
+  {
+    // monitor after the application's own stepping
+    auto multi = new G4MultiSteppingAction;
+    multi->emplace_back(stepping);
+    multi->emplace_back(new QTNMStepMonitor);
+    SetUserAction(multi);
+  }
+  else
+    SetUserAction(stepping);
+  SetUserAction(new SETrackingAction(primary));
+  SetUserAction(new SEStackingAction);
 }
@@ -0,0 +1,103 @@
+#include "SEBiasingOperator.hh"
+#include "SESecondaryOffload.hh"
+
+#include <cfloat>
+
+#include "G4BiasingProcessInterface.hh"
+#include "G4BiasingProcessSharedData.hh"
+#include "G4BOptnChangeCrossSection.hh"
+#include "G4Electron.hh"
+#include "G4ProcessManager.hh"
+#include "G4Track.hh"
+#include "G4VProcess.hh"
+
+
+SEBiasingOperator::SEBiasingOperator()
+: G4VBiasingOperator("SEBiasingOperator")
+, fParticle(G4Electron::Definition())
+{
+  DefineCommands();
+}
+
+SEBiasingOperator::~SEBiasingOperator()
+{
+  delete fMessenger;
+  for(auto& entry : fOperations) delete entry.second;
+}
+
+void SEBiasingOperator::StartRun()
+{
+  // one operation per wrapped electron process, made once
+  if(!fOperations.empty()) return;
+
+  auto sharedData =
+    G4BiasingProcessInterface::GetSharedData(fParticle->GetProcessManager());
+  if(!sharedData) return;  // no biasing physics for electrons
+
+  for(auto wrapper : sharedData->GetPhysicsBiasingProcessInterfaces())
+  {
+    G4String name = "XS-" + wrapper->GetWrappedProcess()->GetProcessName();
+    fOperations[wrapper] = new G4BOptnChangeCrossSection(name);
+  }
+}
+
+G4VBiasingOperation* SEBiasingOperator::ProposeOccurenceBiasingOperation(
+  const G4Track* track, const G4BiasingProcessInterface* callingProcess)
+{
+  if(fFactor == 1. || track->GetDefinition() != fParticle) return nullptr;
+  if(fPrimariesOnly && !SESecondaryOffload::IsPrimary(track)) return nullptr;
+
+  auto entry = fOperations.find(callingProcess);
+  if(entry == fOperations.end()) return nullptr;
+
+  // analog cross-section from the wrapped process for this step
+  G4double analogLength = callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
+  if(analogLength > DBL_MAX / 10.) return nullptr;
+  G4double biasedXS = fFactor / analogLength;
+
+  // sample a new interaction length after an interaction or on entry,
+  // otherwise carry the remaining one over with the updated cross-section
+  auto operation = entry->second;
+  auto previous  = callingProcess->GetPreviousOccurenceBiasingOperation();
+  if(previous != operation || operation->GetInteractionOccured())
+  {
+    operation->SetBiasedCrossSection(biasedXS);
+    operation->Sample();
+  }
+  else
+  {
+    operation->UpdateForStep(callingProcess->GetPreviousStepSize());
+    operation->SetBiasedCrossSection(biasedXS);
+    operation->UpdateForStep(0.);
+  }
+  return operation;
+}
+
+void SEBiasingOperator::OperationApplied(const G4BiasingProcessInterface* callingProcess,
+                                         G4BiasingAppliedCase,
+                                         G4VBiasingOperation* occurenceOperationApplied,
+                                         G4double,
+                                         G4VBiasingOperation*,
+                                         const G4VParticleChange*)
+{
+  auto entry = fOperations.find(callingProcess);
+  if(entry != fOperations.end() && entry->second == occurenceOperationApplied)
+    entry->second->SetInteractionOccured();
+}
+
+void SEBiasingOperator::DefineCommands()
+{
+  // Define /SE/biasing command directory using generic messenger class
+  fMessenger = new G4GenericMessenger(this, "/SE/biasing/", "Cross-section biasing in the gas");
+
+  auto& factorCmd = fMessenger->DeclareProperty("factor", fFactor,
+                                                "Scale factor for the biased electron cross-sections.");
+  factorCmd.SetGuidance("1 switches biasing off.");
+  factorCmd.SetParameterName("f", false);
+  factorCmd.SetRange("f>0.");
+
+  auto& primCmd = fMessenger->DeclareProperty("primariesOnly", fPrimariesOnly,
+                                              "Bias primary electrons only.");
+  primCmd.SetParameterName("flag", true);
+  primCmd.SetDefaultValue("true");
+}
@@ -14,12 +14,19 @@
 #include "G4SolidStore.hh"
 #include "G4Tubs.hh"
 #include "G4PVPlacement.hh"
+#include "G4UserLimits.hh"
 
+#include "G4ChordFinder.hh"
+#include "G4FieldManager.hh"
 #include "G4GlobalMagFieldMessenger.hh"
+#include "G4MagneticField.hh"
+#include "G4TransportationManager.hh"
 #include "G4UniformMagField.hh"
 #include "G4AutoDelete.hh"
 
 #include "G4SDManager.hh"
+#include "SEBiasingOperator.hh"
+#include "SEFieldTuner.hh"
 #include "SEGasSD.hh"
 #include "SEWatchSD.hh"
 
@@ -30,12 +37,16 @@ SEDetectorConstruction::SEDetectorConstruction()
 {
   fdensity = 5.e-12 * g / cm3;
 
+  fFieldTuner = new SEFieldTuner;
+
   DefineCommands();
 }
 
 SEDetectorConstruction::~SEDetectorConstruction()
 {
   delete fDetectorMessenger;
+  delete fFieldTuner;
+  for(auto& entry : fVolumeSettings) delete entry.second.limits;
 }
 
 auto SEDetectorConstruction::Construct() -> G4VPhysicalVolume*
@@ -48,16 +59,22 @@ auto SEDetectorConstruction::Construct() -> G4VPhysicalVolume*
 
   DefineMaterials();
 
+  G4VPhysicalVolume* world = nullptr;
   if(fGeometryName == "bunches")
   {
-    return SetupBunches();
+    world = SetupBunches();
   }
   else if (fGeometryName == "shortPipe")
   {
-    return SetupShort();
+    world = SetupShort();
+  }
+  else
+  {
+    world = SetupBaseline();
   }
 
-  return SetupBaseline();
+  ApplyUserLimits();
+  return world;
 }
 
 void SEDetectorConstruction::DefineMaterials()
@@ -101,6 +118,19 @@ void SEDetectorConstruction::ConstructSDandField()
 
   }
 
+  // Cross-section biasing in the gas, one operator per thread
+  if(fBiasing)
+  {
+    if(!fBiasingOperator.Get())
+    {
+      auto op = new SEBiasingOperator;
+      G4AutoDelete::Register(op);
+      fBiasingOperator.Put(op);
+    }
+    auto gasLV = G4LogicalVolumeStore::GetInstance()->GetVolume("Gas_log");
+    if(gasLV) fBiasingOperator.Get()->AttachTo(gasLV);
+  }
+
   // Field setup
   if( !fFieldMessenger.Get() ) {
     // Create global magnetic field messenger.
@@ -365,6 +395,144 @@ void SEDetectorConstruction::SetDensity(G4double d)
   G4RunManager::GetRunManager()->ReinitializeGeometry();
 }   
 
+SEDetectorConstruction::VolumeSettings& SEDetectorConstruction::SelectedVolume()
+{
+  return fVolumeSettings[fSelectedVolume];
+}
+
+void SEDetectorConstruction::SelectVolume(const G4String& name)
+{
+  std::set<G4String> knownVolumes = { "World_log", "Pipe_log", "Gas_log", "Stop_log" };
+  if(knownVolumes.count(name) == 0)
+  {
+    G4Exception("SEDetectorConstruction::SelectVolume", "SE0001", JustWarning,
+                ("Invalid volume name '" + name + "'").c_str());
+    return;
+  }
+  fSelectedVolume = name;
+}
+
+void SEDetectorConstruction::SetMaxStep(G4double value)
+{
+  auto& vs = SelectedVolume();
+  if(!vs.limits) vs.limits = new G4UserLimits;
+  vs.limits->SetMaxAllowedStep(value);
+  ApplyUserLimits();
+}
+
+void SEDetectorConstruction::SetMaxTrackLength(G4double value)
+{
+  auto& vs = SelectedVolume();
+  if(!vs.limits) vs.limits = new G4UserLimits;
+  vs.limits->SetUserMaxTrackLength(value);
+  ApplyUserLimits();
+}
+
+void SEDetectorConstruction::SetMaxTime(G4double value)
+{
+  auto& vs = SelectedVolume();
+  if(!vs.limits) vs.limits = new G4UserLimits;
+  vs.limits->SetUserMaxTime(value);
+  ApplyUserLimits();
+}
+
+void SEDetectorConstruction::SetMinKinE(G4double value)
+{
+  auto& vs = SelectedVolume();
+  if(!vs.limits) vs.limits = new G4UserLimits;
+  vs.limits->SetUserMinEkine(value);
+  ApplyUserLimits();
+}
+
+void SEDetectorConstruction::SetVolumeDeltaChord(G4double value)
+{
+  auto& vs      = SelectedVolume();
+  vs.ownField   = true;
+  vs.deltaChord = value;
+}
+
+void SEDetectorConstruction::SetVolumeDeltaOneStep(G4double value)
+{
+  auto& vs        = SelectedVolume();
+  vs.ownField     = true;
+  vs.deltaOneStep = value;
+}
+
+void SEDetectorConstruction::SetVolumeEpsMin(G4double value)
+{
+  auto& vs  = SelectedVolume();
+  vs.ownField = true;
+  vs.epsMin = value;
+}
+
+void SEDetectorConstruction::SetVolumeEpsMax(G4double value)
+{
+  auto& vs  = SelectedVolume();
+  vs.ownField = true;
+  vs.epsMax = value;
+}
+
+void SEDetectorConstruction::ApplyUserLimits() const
+{
+  // user limits are shared by all threads, attach to the current volumes
+  auto store = G4LogicalVolumeStore::GetInstance();
+  for(const auto& entry : fVolumeSettings)
+  {
+    if(!entry.second.limits) continue;
+    auto lv = store->GetVolume(entry.first, false);
+    if(lv) lv->SetUserLimits(entry.second.limits);
+  }
+}
+
+void SEDetectorConstruction::SetupVolumeFields() const
+{
+  // Thread-local: field managers are per thread, like the global one
+  // created by the field messenger. The global field may have been
+  // changed since the last run, hence set up at each run start.
+  auto globalManager = G4TransportationManager::GetTransportationManager()->GetFieldManager();
+  auto field = dynamic_cast<const G4MagneticField*>(globalManager->GetDetectorField());
+
+  auto  store    = G4LogicalVolumeStore::GetInstance();
+  auto& managers = fVolumeFields.Get();
+  for(const auto& entry : fVolumeSettings)
+  {
+    const auto& vs = entry.second;
+    if(!vs.ownField) continue;
+
+    auto lv = store->GetVolume(entry.first, false);
+    if(!lv) continue;
+
+    if(!field)
+    {
+      lv->SetFieldManager(nullptr, false);
+      continue;
+    }
+
+    auto& fm = managers[entry.first];
+    if(!fm)
+    {
+      fm = new G4FieldManager;
+      G4AutoDelete::Register(fm);
+    }
+    if(fm->GetDetectorField() != field || !fm->GetChordFinder())
+    {
+      auto magField = const_cast<G4MagneticField*>(field);
+      fm->SetDetectorField(magField);
+      fm->CreateChordFinder(magField);
+    }
+
+    // global accuracy, then volume specific settings
+    fFieldTuner->Apply(fm);
+    if(vs.epsMin > 0.)       fm->SetMinimumEpsilonStep(vs.epsMin);
+    if(vs.epsMax > 0.)       fm->SetMaximumEpsilonStep(vs.epsMax);
+    if(vs.deltaOneStep > 0.) fm->SetDeltaOneStep(vs.deltaOneStep);
+    if(vs.deltaChord > 0.)   fm->GetChordFinder()->SetDeltaChord(vs.deltaChord);
+
+    // daughters without own settings follow the mother volume
+    lv->SetFieldManager(fm, false);
+  }
+}
+
 void SEDetectorConstruction::DefineCommands()
 {
   // Define geometry command directory using generic messenger class
@@ -386,4 +554,58 @@ void SEDetectorConstruction::DefineCommands()
     .SetStates(G4State_PreInit)
     .SetToBeBroadcasted(false);
 
+  // per-volume settings, applying to the volume last selected
+  fDetectorMessenger->DeclareMethod("selectVolume", &SEDetectorConstruction::SelectVolume)
+    .SetGuidance("Select logical volume for the following step limit and field commands")
+    .SetCandidates("World_log Pipe_log Gas_log Stop_log")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fDetectorMessenger->DeclareMethodWithUnit("setMaxStep", "mm", &SEDetectorConstruction::SetMaxStep)
+    .SetGuidance("Maximum step length in the selected volume")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fDetectorMessenger->DeclareMethodWithUnit("setMaxTrackLength", "mm",
+                                            &SEDetectorConstruction::SetMaxTrackLength)
+    .SetGuidance("Maximum track length in the selected volume")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fDetectorMessenger->DeclareMethodWithUnit("setMaxTime", "ns", &SEDetectorConstruction::SetMaxTime)
+    .SetGuidance("Maximum global time in the selected volume")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fDetectorMessenger->DeclareMethodWithUnit("setMinKinE", "keV", &SEDetectorConstruction::SetMinKinE)
+    .SetGuidance("Minimum kinetic energy in the selected volume")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fDetectorMessenger->DeclareMethodWithUnit("setDeltaChord", "mm",
+                                            &SEDetectorConstruction::SetVolumeDeltaChord)
+    .SetGuidance("Chord miss distance in the selected volume, own field manager")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fDetectorMessenger->DeclareMethodWithUnit("setDeltaOneStep", "mm",
+                                            &SEDetectorConstruction::SetVolumeDeltaOneStep)
+    .SetGuidance("Integration step accuracy in the selected volume, own field manager")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fDetectorMessenger->DeclareMethod("setEpsMin", &SEDetectorConstruction::SetVolumeEpsMin)
+    .SetGuidance("Minimum relative accuracy in the selected volume, own field manager")
+    .SetParameterName("eps", false)
+    .SetRange("eps>0. && eps<=0.01")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fDetectorMessenger->DeclareMethod("setEpsMax", &SEDetectorConstruction::SetVolumeEpsMax)
+    .SetGuidance("Maximum relative accuracy in the selected volume, own field manager")
+    .SetParameterName("eps", false)
+    .SetRange("eps>0. && eps<=0.01")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
 }
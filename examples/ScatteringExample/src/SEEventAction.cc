@@ -1,8 +1,14 @@
 #include "SEEventAction.hh"
+#include "SERadiationSignal.hh"
+#include "SESecondaryOffload.hh"
+#include "SETrackInformation.hh"
+#include "QTNMEventSeeding.hh"
+#include "QTNMTelemetry.hh"
 #include "g4root.hh"
 
 #include <vector>
 
+#include "G4AccumulableManager.hh"
 #include "G4Event.hh"
 #include "G4HCofThisEvent.hh"
 #include "G4SDManager.hh"
@@ -12,6 +18,22 @@
 #include "SEWatchSD.hh"
 
 
+SEEventAction::SEEventAction(SERadiationSignal* signal)
+: G4UserEventAction()
+, fSignal(signal)
+{
+  // before the run action's, in the same order on master and workers
+  auto accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->RegisterAccumulable(fEdepEvents);
+  accumulableManager->RegisterAccumulable(fEdepSum);
+  accumulableManager->RegisterAccumulable(fEdepSum2);
+}
+
+SEEventAction::~SEEventAction()
+{
+  delete fSignal;
+}
+
 SEGasHitsCollection* 
 SEEventAction::GetGasHitsCollection(G4int hcID,
                                     const G4Event* event) const
@@ -52,10 +74,16 @@ SEEventAction::GetWatchHitsCollection(G4int hcID,
 
 void SEEventAction::BeginOfEventAction(const G4Event*
                                          /*event*/)
-{ ; }
+{
+  if(fSignal) fSignal->BeginOfEvent();
+}
 
 void SEEventAction::EndOfEventAction(const G4Event* event)
 {
+  // progress, instead of printing every event
+  G4int subEvent = SESecondaryOffload::SubEvent();
+  if(subEvent == 0) QTNMTelemetry::EndOfEvent();
+
   // Get GAS hits collections IDs
   if(fGID < 0) 
     fGID = G4SDManager::GetSDMpointer()->GetCollectionID("GasHitsCollection");
@@ -68,14 +96,29 @@ void SEEventAction::EndOfEventAction(const G4Event* event)
   auto GasHC     = GetGasHitsCollection(fGID, event);
   auto WatchHC   = GetWatchHitsCollection(fWID, event);
 
+  // weighted energy deposit, summed over sub-events before squaring
+  G4double edep = 0.;
+  for ( G4int i=0; i<(G4int)GasHC->entries(); i++ )
+    edep += (*GasHC)[i]->GetWeight() * (*GasHC)[i]->GetEdep();
+  G4double total = 0.;
+  if(SESecondaryOffload::Collect(event->GetEventID(), edep, total))
+  {
+    fEdepEvents += 1;
+    fEdepSum    += total;
+    fEdepSum2   += total * total;
+  }
+
+  // antenna signal, independent of hits
+  if(fSignal) fSignal->EndOfEvent((G4int) QTNMEventSeeding::EventID(event));
+
   if(GasHC->entries() <= 0 && WatchHC->entries() <= 0)
   {
     return;  // no action on no hit
   }
 
   // dummy storage
-  std::vector<double> tkin, tedep, ttime, tex, xp, yp;
-  std::vector<int> hid, pid, texid;
+  std::vector<double> tkin, tedep, ttime, tex, xp, yp, gw, ww;
+  std::vector<int> hid, pid, texid, gprim, wprim;
 
   // get analysis manager
   auto analysisManager = G4AnalysisManager::Instance();
@@ -95,6 +138,8 @@ void SEEventAction::EndOfEventAction(const G4Event* event)
     int id1  =  hh->GetTrackID();
     int id2  =  hh->GetParentID();
 
+    gprim.push_back(hh->GetPrimary());
+    gw.push_back(hh->GetWeight());
     tedep.push_back(e);
     tkin.push_back(k);
     ttime.push_back(t);
@@ -111,6 +156,8 @@ void SEEventAction::EndOfEventAction(const G4Event* event)
     double x = (hh->GetPos()).x() / G4Analysis::GetUnitValue("mm");
     double y = (hh->GetPos()).y() / G4Analysis::GetUnitValue("mm");
   
+    wprim.push_back(hh->GetPrimary());
+    ww.push_back(hh->GetWeight());
     texid.push_back(id);
     tex.push_back(t);
     xp.push_back(x);
@@ -118,10 +165,11 @@ void SEEventAction::EndOfEventAction(const G4Event* event)
   }
 
   // fill the ntuple - check column id?
-  G4int eventID = event->GetEventID();
+  // event ID per primary, as if each had its own event
+  G4int eventID = (G4int) QTNMEventSeeding::EventID(event);
   for (unsigned int i=0;i<tedep.size();i++)
   {
-    analysisManager->FillNtupleIColumn(0, 0, eventID); // repeat all rows
+    analysisManager->FillNtupleIColumn(0, 0, SETrackInformation::VirtualEventID(eventID, gprim.at(i)));
     analysisManager->FillNtupleDColumn(0, 1, tedep.at(i));
     analysisManager->FillNtupleDColumn(0, 2, tkin.at(i));
     analysisManager->FillNtupleDColumn(0, 3, ttime.at(i)); // same size
@@ -134,20 +182,19 @@ void SEEventAction::EndOfEventAction(const G4Event* event)
       analysisManager->FillNtupleIColumn(0, 4, hid.at(i));
       analysisManager->FillNtupleIColumn(0, 5, pid.at(i));
     }
+    analysisManager->FillNtupleDColumn(0, 6, gw.at(i));
+    analysisManager->FillNtupleIColumn(0, 7, subEvent);
     analysisManager->AddNtupleRow(0);
   }
   for (unsigned int i=0;i<texid.size();i++)
   {
-    analysisManager->FillNtupleIColumn(1, 0, eventID); // repeat all rows
+    analysisManager->FillNtupleIColumn(1, 0, SETrackInformation::VirtualEventID(eventID, wprim.at(i)));
     analysisManager->FillNtupleIColumn(1, 1, texid.at(i));
     analysisManager->FillNtupleDColumn(1, 2, tex.at(i));
     analysisManager->FillNtupleDColumn(1, 3, xp.at(i));
     analysisManager->FillNtupleDColumn(1, 4, yp.at(i));
+    analysisManager->FillNtupleDColumn(1, 5, ww.at(i));
+    analysisManager->FillNtupleIColumn(1, 6, subEvent);
     analysisManager->AddNtupleRow(1);
   }
-
-  // printing
-  G4cout << ">>> Event: " << eventID << G4endl;
-  G4cout << "    " << GnofHits << " gas hits stored in this event." << G4endl;
-  G4cout << "    " << WnofHits << " stopwatch hits stored in this event." << G4endl;
 }
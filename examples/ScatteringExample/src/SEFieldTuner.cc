@@ -0,0 +1,296 @@
+#include "SEFieldTuner.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+#include "G4ChargeState.hh"
+#include "G4ChordFinder.hh"
+#include "G4EquationOfMotion.hh"
+#include "G4FieldManager.hh"
+#include "G4FieldTrack.hh"
+#include "G4UniformMagField.hh"
+#include "G4VIntegrationDriver.hh"
+
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+
+namespace
+{
+  // accepted range of the relative integration accuracy in G4FieldManager
+  const G4double kEpsLimit = 1.e-2;
+
+  // guard against stalled propagation in the benchmark
+  const G4long kMaxSteps = 10000000;
+
+  // relative difference of median times taken as equal
+  const G4double kTimeResolution = 0.05;
+}
+
+SEFieldTuner::SEFieldTuner()
+: fDeltaChord(0.25 * mm)
+, fDeltaOneStep(0.01 * mm)
+, fDeltaIntersection(0.001 * mm)
+{
+  DefineCommands();
+}
+
+SEFieldTuner::~SEFieldTuner()
+{
+  delete fMessenger;
+  delete fTuneMessenger;
+}
+
+void SEFieldTuner::Apply(G4FieldManager* fieldManager) const
+{
+  if(!fieldManager) return;
+
+  // the maximum is checked against the current minimum, set that first
+  fieldManager->SetMinimumEpsilonStep(fEpsMin);
+  fieldManager->SetMaximumEpsilonStep(fEpsMax);
+  fieldManager->SetDeltaOneStep(fDeltaOneStep);
+  fieldManager->SetDeltaIntersection(fDeltaIntersection);
+  if(fieldManager->GetChordFinder())
+    fieldManager->GetChordFinder()->SetDeltaChord(fDeltaChord);
+}
+
+SEFieldTuner::Outcome SEFieldTuner::Benchmark(const Settings& settings) const
+{
+  // same chord finder as created for the global field
+  G4UniformMagField field(G4ThreeVector(0., 0., fTuneField * tesla));
+  G4ChordFinder chordFinder(&field);
+  chordFinder.SetDeltaChord(settings.deltaChord);
+
+  G4double mass   = electron_mass_c2;
+  G4double charge = -1.;  // [eplus]
+  G4double ekin   = fTuneEnergy * keV;
+  G4double p      = std::sqrt(ekin * (ekin + 2. * mass));
+  G4double pitch  = fTunePitch * deg;
+
+  auto equation = chordFinder.GetIntegrationDriver()->GetEquationOfMotion();
+  equation->SetChargeMomentumMass(G4ChargeState(charge, 0., 0., 0.), p, mass);
+
+  // gyration angle per unit path length
+  G4double omega  = std::abs(charge) * c_light * fTuneField * tesla / p;
+  G4double length = fTuneTurns * twopi / omega;
+
+  // the propagation is deterministic, repeat it for the timing only
+  Outcome outcome;
+  std::vector<G4double> seconds;
+  for(G4int repeat = 0; repeat < std::max(fTuneRepeats, 1); ++repeat)
+  {
+    G4FieldTrack track(G4ThreeVector(), 0.,
+                       G4ThreeVector(std::sin(pitch), 0., std::cos(pitch)),
+                       ekin, mass, charge, G4ThreeVector());
+
+    G4double travelled = 0.;
+    G4long   nSteps    = 0;
+    auto start = std::chrono::steady_clock::now();
+    while(travelled < length && nSteps < kMaxSteps)
+    {
+      // physics steps of the requested length, accuracy as chosen by
+      // G4PropagatorInField for that step
+      G4double request = std::min(fTuneStep * mm, length - travelled);
+      G4double eps = std::min(std::max(settings.deltaOneStep / request, settings.epsMin),
+                              settings.epsMax);
+      G4double step = chordFinder.AdvanceChordLimited(track, request, eps,
+                                                      track.GetPosition(), 0.);
+      if(step <= 0.) break;
+      travelled += step;
+      ++nSteps;
+    }
+    std::chrono::duration<G4double> elapsed = std::chrono::steady_clock::now() - start;
+    seconds.push_back(elapsed.count());
+
+    // compare with the analytic helix at the same path length,
+    // negative charges turn anti-clockwise about +z
+    G4ThreeVector pEnd = track.GetMomentum();
+    G4double ekinEnd   = std::sqrt(pEnd.mag2() + mass * mass) - mass;
+    G4double expected  = -charge / std::abs(charge) * omega * track.GetCurveLength();
+    G4double numeric   = std::atan2(pEnd.y(), pEnd.x());
+
+    outcome.energyError = std::abs(ekinEnd - ekin) / ekin;
+    outcome.phaseError  = std::abs(std::remainder(numeric - expected, twopi));
+    outcome.nSteps      = nSteps;
+  }
+
+  // median, robust against single slow repetitions
+  std::nth_element(seconds.begin(), seconds.begin() + seconds.size() / 2, seconds.end());
+  outcome.seconds = seconds[seconds.size() / 2];
+  return outcome;
+}
+
+void SEFieldTuner::Tune()
+{
+  G4cout << ">> Field tuning: e- " << fTuneEnergy << " keV, pitch " << fTunePitch
+         << " deg, " << fTuneTurns << " turns in " << fTuneField << " T" << G4endl
+         << "   tolerances: energy " << fEnergyTolerance << " (relative), phase "
+         << fPhaseTolerance << " rad" << G4endl;
+
+  // loosen chord and integration accuracy independently
+  // relative to the current settings
+  const std::vector<G4double> chordScales    = { 1., 2., 4., 8., 16., 32., 64., 128., 256. };
+  const std::vector<G4double> accuracyScales = { 0.0625, 0.25, 1., 4., 16., 64., 256., 1024. };
+
+  Settings current{ fDeltaChord, fDeltaOneStep, fEpsMin, fEpsMax };
+  Outcome  reference = Benchmark(current);
+
+  Settings best      = current;
+  Outcome  bestOut   = reference;
+  G4bool   found     = false;
+
+  G4cout << std::setw(12) << "DeltaChord" << std::setw(14) << "DeltaOneStep"
+         << std::setw(12) << "epsMin" << std::setw(12) << "epsMax"
+         << std::setw(14) << "dE/E" << std::setw(12) << "dphi"
+         << std::setw(10) << "steps" << std::setw(12) << "time [s]" << G4endl;
+
+  for(auto cs : chordScales)
+  {
+    for(auto as : accuracyScales)
+    {
+      Settings trial;
+      trial.deltaChord   = cs * current.deltaChord;
+      trial.deltaOneStep = as * current.deltaOneStep;
+      trial.epsMax       = std::min(as * current.epsMax, kEpsLimit);
+      trial.epsMin       = std::min(as * current.epsMin, trial.epsMax);
+
+      Outcome out = Benchmark(trial);
+      G4bool  ok  = out.energyError <= fEnergyTolerance && out.phaseError <= fPhaseTolerance;
+
+      G4cout << std::setw(12) << trial.deltaChord / mm << std::setw(14) << trial.deltaOneStep / mm
+             << std::setw(12) << trial.epsMin << std::setw(12) << trial.epsMax
+             << std::setw(14) << out.energyError << std::setw(12) << out.phaseError
+             << std::setw(10) << out.nSteps << std::setw(12) << out.seconds
+             << (ok ? "" : "  fail") << G4endl;
+
+      // faster only if beyond the timing noise, else fewer steps decide
+      G4bool faster = out.seconds < (1. - kTimeResolution) * bestOut.seconds
+                      || (out.seconds <= (1. + kTimeResolution) * bestOut.seconds
+                          && out.nSteps < bestOut.nSteps);
+      if(ok && (!found || faster))
+      {
+        best    = trial;
+        bestOut = out;
+        found   = true;
+      }
+    }
+  }
+
+  if(!found)
+  {
+    G4ExceptionDescription msg;
+    msg << "No field propagation settings meet the tolerances,"
+        << " settings unchanged and no macro written.";
+    G4Exception("SEFieldTuner::Tune()", "SE0003", JustWarning, msg);
+    return;
+  }
+
+  G4cout << ">> Field tuning: selected DeltaChord " << best.deltaChord / mm
+         << " mm, DeltaOneStep " << best.deltaOneStep / mm << " mm, epsMin "
+         << best.epsMin << ", epsMax " << best.epsMax << "; speed-up "
+         << reference.seconds / bestOut.seconds << " w.r.t. current settings" << G4endl;
+
+  fDeltaChord   = best.deltaChord;
+  fDeltaOneStep = best.deltaOneStep;
+  fEpsMin       = best.epsMin;
+  fEpsMax       = best.epsMax;
+  WriteMacro(best, bestOut);
+}
+
+void SEFieldTuner::WriteMacro(const Settings& settings, const Outcome& outcome) const
+{
+  std::ofstream out(fMacroName);
+  if(!out)
+  {
+    G4ExceptionDescription msg;
+    msg << "Cannot open " << fMacroName << " for writing.";
+    G4Exception("SEFieldTuner::WriteMacro()", "SE0004", JustWarning, msg);
+    return;
+  }
+
+  out << "# field propagation settings from /SE/field/tune" << std::endl
+      << "# benchmark: e- " << fTuneEnergy << " keV, pitch " << fTunePitch << " deg, "
+      << fTuneTurns << " turns in " << fTuneField << " T" << std::endl
+      << "# errors: energy " << outcome.energyError << " (relative), phase "
+      << outcome.phaseError << " rad" << std::endl
+      << std::setprecision(8)
+      << "/SE/field/setDeltaChord " << settings.deltaChord / mm << " mm" << std::endl
+      << "/SE/field/setDeltaOneStep " << settings.deltaOneStep / mm << " mm" << std::endl
+      << "/SE/field/setDeltaIntersection " << fDeltaIntersection / mm << " mm" << std::endl
+      << "/SE/field/setEpsMin " << settings.epsMin << std::endl
+      << "/SE/field/setEpsMax " << settings.epsMax << std::endl;
+
+  G4cout << ">> Field tuning: settings written to " << fMacroName << G4endl;
+}
+
+void SEFieldTuner::DefineCommands()
+{
+  // Define /SE/field command directory using generic messenger class
+  fMessenger = new G4GenericMessenger(this, "/SE/field/",
+                                      "Field propagation accuracy");
+
+  fMessenger->DeclarePropertyWithUnit("setDeltaChord", "mm", fDeltaChord,
+                                      "Maximum miss distance of a chord.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclarePropertyWithUnit("setDeltaOneStep", "mm", fDeltaOneStep,
+                                      "Position accuracy of one integration step.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclarePropertyWithUnit("setDeltaIntersection", "mm", fDeltaIntersection,
+                                      "Accuracy of boundary intersections.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  auto& minCmd = fMessenger->DeclareProperty("setEpsMin", fEpsMin,
+                                             "Minimum relative integration accuracy.");
+  minCmd.SetParameterName("eps", false);
+  minCmd.SetRange("eps>0. && eps<=0.01");
+  minCmd.SetStates(G4State_PreInit, G4State_Idle);
+  minCmd.SetToBeBroadcasted(false);
+
+  auto& maxCmd = fMessenger->DeclareProperty("setEpsMax", fEpsMax,
+                                             "Maximum relative integration accuracy.");
+  maxCmd.SetParameterName("eps", false);
+  maxCmd.SetRange("eps>0. && eps<=0.01");
+  maxCmd.SetStates(G4State_PreInit, G4State_Idle);
+  maxCmd.SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("tune", &SEFieldTuner::Tune)
+    .SetGuidance("Calibrate the settings in a uniform field benchmark")
+    .SetGuidance("and write them to the tuner macro file.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  // calibration benchmark
+  fTuneMessenger = new G4GenericMessenger(this, "/SE/field/tuner/",
+                                          "Field propagation calibration");
+
+  fTuneMessenger->DeclareProperty("field", fTuneField, "Benchmark field [T].")
+    .SetToBeBroadcasted(false);
+  fTuneMessenger->DeclareProperty("energy", fTuneEnergy, "Electron energy [keV].")
+    .SetToBeBroadcasted(false);
+  fTuneMessenger->DeclareProperty("pitch", fTunePitch, "Pitch angle to the field [deg].")
+    .SetToBeBroadcasted(false);
+  fTuneMessenger->DeclareProperty("turns", fTuneTurns, "Number of gyrations.")
+    .SetToBeBroadcasted(false);
+  fTuneMessenger->DeclareProperty("step", fTuneStep,
+                                  "Requested step length [mm], as limited by physics or user limits.")
+    .SetToBeBroadcasted(false);
+  fTuneMessenger->DeclareProperty("repeats", fTuneRepeats,
+                                  "Timed repetitions per setting, the median is used.")
+    .SetToBeBroadcasted(false);
+  fTuneMessenger->DeclareProperty("energyTolerance", fEnergyTolerance,
+                                  "Relative kinetic energy tolerance.")
+    .SetToBeBroadcasted(false);
+  fTuneMessenger->DeclareProperty("phaseTolerance", fPhaseTolerance,
+                                  "Gyro-phase tolerance after all turns [rad].")
+    .SetToBeBroadcasted(false);
+  fTuneMessenger->DeclareProperty("macro", fMacroName, "Output macro file name.")
+    .SetToBeBroadcasted(false);
+}
@@ -8,7 +8,9 @@ SEGasHit::SEGasHit()
    fTime(0.),
    fKine(0.),
    fEdep(0.),
-   fPid(0)
+   fPid(0),
+   fPrimary(0),
+   fWeight(1.)
 {}
 
 SEGasHit::~SEGasHit() {}
@@ -21,6 +23,8 @@ SEGasHit::SEGasHit(const SEGasHit& right)
   fTime      = right.fTime;
   fEdep      = right.fEdep;
   fKine      = right.fKine;
+  fPrimary   = right.fPrimary;
+  fWeight    = right.fWeight;
 }
 
 const SEGasHit& SEGasHit::operator=(const SEGasHit& right)
@@ -30,6 +34,8 @@ const SEGasHit& SEGasHit::operator=(const SEGasHit& right)
   fTime      = right.fTime;
   fEdep      = right.fEdep;
   fKine      = right.fKine;
+  fPrimary   = right.fPrimary;
+  fWeight    = right.fWeight;
 
   return *this;
 }
@@ -1,4 +1,5 @@
 #include "SEGasSD.hh"
+#include "SETrackInformation.hh"
 #include "G4HCofThisEvent.hh"
 #include "G4Step.hh"
 #include "G4ThreeVector.hh"
@@ -45,6 +46,9 @@ G4bool SEGasSD::ProcessHits(G4Step* aStep,
   newHit->SetTime(aStep->GetTrack()->GetGlobalTime());
   newHit->SetEdep(edep);
   newHit->SetKine(aStep->GetPostStepPoint()->GetKineticEnergy());
+  newHit->SetPrimary(SETrackInformation::GetPrimary(aStep->GetTrack()));
+  // weight after the step: a biased interaction sets it in this step
+  newHit->SetWeight(aStep->GetTrack()->GetWeight());
 
   fHitsCollection->insert( newHit );
 
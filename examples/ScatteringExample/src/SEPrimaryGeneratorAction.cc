@@ -1,5 +1,8 @@
 // us
 #include "SEPrimaryGeneratorAction.hh"
+#include "QTNMEventSeeding.hh"
+#include "QTNMPhaseSpace.hh"
+#include "SETrackInformation.hh"
 
 // geant
 #include "G4Event.hh"
@@ -12,10 +15,12 @@
 #include "G4LogicalVolumeStore.hh"
 #include "G4LogicalVolume.hh"
 #include "G4Box.hh"
+#include "Randomize.hh"
 
 SEPrimaryGeneratorAction::SEPrimaryGeneratorAction()
 : G4VUserPrimaryGeneratorAction()
 , fParticleGun(nullptr)
+, fEndpoint(18.575*keV)
 {
   G4int nofParticles = 1;
   fParticleGun       = new G4ParticleGun(nofParticles);
@@ -26,24 +31,172 @@ SEPrimaryGeneratorAction::SEPrimaryGeneratorAction()
   fParticleGun->SetParticleDefinition(particleTable->FindParticle("e-"));
   fParticleGun->SetParticleMomentumDirection(G4ThreeVector(0.,0.,1.)); // z-axis
   fParticleGun->SetParticleEnergy(18.575*keV);
+
+  DefineCommands();
 }
 
 SEPrimaryGeneratorAction::~SEPrimaryGeneratorAction()
 {
+  delete fReader;
+  delete fPhaseSpaceGun;
+  delete fMessenger;
   delete fParticleGun;
 }
 
-void SEPrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
+void SEPrimaryGeneratorAction::UpdateGeometry()
 {
   // In order to avoid dependence of PrimaryGeneratorAction
   // on DetectorConstruction class we get world volume 
   // from G4LogicalVolumeStore: assumes name is World_log!
   //
   auto worldLV = G4LogicalVolumeStore::GetInstance()->GetVolume("World_log");
-  G4Box* worldBox = dynamic_cast<G4Box*>(worldLV->GetSolid());
+  G4Box* worldBox = worldLV ? dynamic_cast<G4Box*>(worldLV->GetSolid()) : nullptr;
+  if(!worldBox)
+  {
+    G4Exception("SEPrimaryGeneratorAction::UpdateGeometry()", "SE0005",
+                FatalException, "World_log box volume not found.");
+    return;
+  }
   G4double worldZHalfLength = worldBox->GetZHalfLength();
-  fParticleGun->SetParticlePosition(G4ThreeVector(0, 0, -worldZHalfLength + 1.*cm));
+  fSourcePos = G4ThreeVector(0, 0, -worldZHalfLength + 1.*cm);
+  fParticleGun->SetParticlePosition(fSourcePos);
+  fGeometryValid = true;
+}
+
+void SEPrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
+{
+  // random numbers of this event independent of thread and job
+  QTNMEventSeeding::SeedEvent(event);
+
+  // geometry only changes between runs
+  if(!fGeometryValid) UpdateGeometry();
+
+  // stop before tracking if the last primary's virtual ID does not fit
+  if(fNPrimaries > 1)
+    SETrackInformation::VirtualEventID((G4int) QTNMEventSeeding::EventID(event), fNPrimaries - 1);
+
+  // independent primaries, track IDs 1..n in this order
+  for(G4int k = 0; k < fNPrimaries; ++k)
+  {
+    if(fPhaseSpace != "none")
+    {
+      GeneratePhaseSpace(event, (std::size_t) QTNMEventSeeding::EventID(event) * fNPrimaries + k);
+      continue;
+    }
+
+    if(fSpectrum == "beta")
+    {
+      fBeta.Configure(fEndpoint, fWindowMin, fWindowMax);
+      G4double u1 = G4UniformRand();
+      G4double u2 = G4UniformRand();
+      fParticleGun->SetParticleEnergy(fBeta.Sample(u1, u2));
+    }
+
+    fParticleGun->GeneratePrimaryVertex(event);
+  }
+}
+
+void SEPrimaryGeneratorAction::GeneratePhaseSpace(G4Event* event, std::size_t index)
+{
+  // (re)map on a new file name, the mapping is kept across runs
+  if(!fReader || fReader->GetName() != fPhaseSpace)
+  {
+    delete fReader;
+    fReader    = new QTNMPhaseSpaceReader(fPhaseSpace);
+    fReaderPDG = 0;
+    fRecycled  = false;
+  }
+  if(fReaderPDG != fPDG)
+  {
+    fReader->SetPDG(fPDG);
+    fReaderPDG = fPDG;
+  }
+
+  std::size_t nRecords = fReader->GetEntries();
+  if(nRecords == 0)
+  {
+    G4ExceptionDescription msg;
+    msg << "No selected records in phase-space file " << fPhaseSpace << ".";
+    G4Exception("SEPrimaryGeneratorAction::GeneratePhaseSpace()", "SE0006",
+                FatalException, msg);
+    return;
+  }
+
+  if(index >= nRecords && !fRecycled)
+  {
+    G4ExceptionDescription msg;
+    msg << "More events than the " << nRecords << " selected records in "
+        << fPhaseSpace << ", records are reused.";
+    G4Exception("SEPrimaryGeneratorAction::GeneratePhaseSpace()", "SE0006",
+                JustWarning, msg);
+    fRecycled = true;
+  }
+  const auto& record = fReader->GetRecord(index % nRecords);
+
+  auto particle = G4ParticleTable::GetParticleTable()->FindParticle(record.pdg);
+  if(!particle)
+  {
+    G4ExceptionDescription msg;
+    msg << "Unknown PDG code " << record.pdg << " in " << fPhaseSpace << ".";
+    G4Exception("SEPrimaryGeneratorAction::GeneratePhaseSpace()", "SE0006",
+                FatalException, msg);
+    return;
+  }
+
+  // records in internal units, placed relative to the source position
+  G4ThreeVector position = fSourcePos;
+  if(fKeepPosition)
+    position += G4ThreeVector(record.pos[0], record.pos[1], record.pos[2]);
+
+  // own gun, the macro settings of the main gun stay for later runs
+  if(!fPhaseSpaceGun) fPhaseSpaceGun = new G4ParticleGun(1);
+  fPhaseSpaceGun->SetParticleDefinition(particle);
+  fPhaseSpaceGun->SetParticleEnergy(record.kine);
+  fPhaseSpaceGun->SetParticleMomentumDirection(
+    G4ThreeVector(record.dir[0], record.dir[1], record.dir[2]));
+  fPhaseSpaceGun->SetParticlePosition(position);
+  fPhaseSpaceGun->GeneratePrimaryVertex(event);
+}
+
+void SEPrimaryGeneratorAction::DefineCommands()
+{
+  // Define /SE/generator command directory using generic messenger class
+  fMessenger =
+    new G4GenericMessenger(this, "/SE/generator/", "Primary generator control");
+
+  auto& nCmd = fMessenger->DeclareProperty("primaries", fNPrimaries,
+                                           "Independent primaries per event.");
+  nCmd.SetGuidance("Hits keep the primary index, output the virtual event ID");
+  nCmd.SetGuidance("event ID * primaries + primary index, at most 2^31 - 1.");
+  nCmd.SetParameterName("n", false);
+  nCmd.SetRange("n>0");
+  nCmd.SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("spectrum", fSpectrum,
+                              "Gun energy: mono, as set by /gun/energy, or beta for tritium decay.")
+    .SetCandidates("mono beta");
+
+  fMessenger->DeclarePropertyWithUnit("endpoint", "keV", fEndpoint,
+                                      "Beta spectrum endpoint.");
+
+  fMessenger->DeclarePropertyWithUnit("windowMin", "keV", fWindowMin,
+                                      "Lowest sampled beta energy.");
+
+  fMessenger->DeclarePropertyWithUnit("windowMax", "keV", fWindowMax,
+                                      "Highest sampled beta energy, 0 for the endpoint.");
+
+  fMessenger->DeclareProperty("phaseSpace", fPhaseSpace,
+                              "Read primaries from this phase-space file, none for the gun.");
+
+  auto& pdgCmd = fMessenger->DeclareProperty("pdg", fPDG,
+                                             "Use phase-space records of this PDG code only, 0 for all.");
+  pdgCmd.SetParameterName("code", true);
+  pdgCmd.SetDefaultValue("0");
 
-  fParticleGun->GeneratePrimaryVertex(event);
+  auto& posCmd = fMessenger->DeclareProperty("keepPosition", fKeepPosition,
+                                             "Offset phase-space primaries by their recorded position.");
+  posCmd.SetGuidance("Otherwise all start at the source position.");
+  posCmd.SetParameterName("flag", true);
+  posCmd.SetDefaultValue("true");
 }
 
@@ -0,0 +1,213 @@
+#include "SERadiationSignal.hh"
+#include "SESecondaryOffload.hh"
+#include "SETrackInformation.hh"
+#include "g4root.hh"
+
+#include <cmath>
+
+#include "G4AutoLock.hh"
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+
+namespace
+{
+  // largest turn of the velocity vector in one step before the step is
+  // flagged as undersampling the cyclotron motion, ~1/12 of a gyration
+  const G4double kMaxTurn = pi / 6.;
+
+  // run total of steps outside the output window, filled by all threads
+  G4Mutex signalMutex = G4MUTEX_INITIALIZER;
+  G4long  runOutOfWindow = 0;
+
+  // this thread's signal, to flush from the run action
+  G4ThreadLocal SERadiationSignal* threadInstance = nullptr;
+}
+
+SERadiationSignal::SERadiationSignal()
+: fAntennaPos(2. * cm, 0., 0.)   // on the pipe wall
+, fPolarisation(0., 1., 0.)
+{
+  threadInstance = this;
+  DefineCommands();
+}
+
+SERadiationSignal::~SERadiationSignal()
+{
+  if(threadInstance == this) threadInstance = nullptr;
+  delete fMessenger;
+}
+
+void SERadiationSignal::Flush()
+{
+  if(!threadInstance) return;
+
+  G4AutoLock lock(&signalMutex);
+  runOutOfWindow += threadInstance->fOutOfWindow;
+  threadInstance->fOutOfWindow = 0;
+}
+
+void SERadiationSignal::Report()
+{
+  G4AutoLock lock(&signalMutex);
+  if(runOutOfWindow == 0) return;
+
+  G4cout << ">>> Signal: " << runOutOfWindow
+         << " radiating steps outside the signal window." << G4endl;
+  runOutOfWindow = 0;
+}
+
+void SERadiationSignal::BeginOfEvent()
+{
+  if(!fActive) return;
+
+  if(fPolarisation.mag2() <= 0.)
+  {
+    G4ExceptionDescription msg;
+    msg << "Antenna polarisation must be a non-zero vector.";
+    G4Exception("SERadiationSignal::BeginOfEvent()",
+      "SE0001", FatalErrorInArgument, msg);
+  }
+  fPolUnit  = fPolarisation.unit();
+  fOmegaLO  = twopi * fLOFrequency * 1000. * megahertz;
+  fBinWidth = 1. / (fSampleRate * megahertz);
+
+  // bins of each primary, allocated on its first radiating step
+  for(auto& samples : fSamples) samples.clear();
+  fUndersampled = 0;
+}
+
+void SERadiationSignal::AddStep(const G4Step* step)
+{
+  G4double charge = step->GetTrack()->GetDefinition()->GetPDGCharge();
+  G4double dt     = step->GetDeltaTime();
+  if(charge == 0. || dt <= 0.) return;
+
+  auto pre  = step->GetPreStepPoint();
+  auto post = step->GetPostStepPoint();
+
+  G4ThreeVector beta0 = (pre->GetVelocity() / c_light) * pre->GetMomentumDirection();
+  G4ThreeVector beta1 = (post->GetVelocity() / c_light) * post->GetMomentumDirection();
+  G4ThreeVector betaDot = (beta1 - beta0) / dt;
+  if(betaDot.mag2() == 0.) return;  // no radiation from uniform motion
+
+  G4ThreeVector beta = 0.5 * (beta0 + beta1);
+  G4ThreeVector r    = 0.5 * (pre->GetPosition() + post->GetPosition());
+  G4ThreeVector R    = fAntennaPos - r;
+  G4double dist      = R.mag();
+  if(dist <= 0.) return;
+  G4ThreeVector n    = R / dist;
+
+  // far-field (acceleration) term of the Lienard-Wiechert field,
+  // evaluated at the retarded step midpoint
+  G4double kappa  = 1. - n.dot(beta);
+  G4double factor = charge / (4. * pi * epsilon0 * c_light * kappa * kappa * kappa * dist);
+  G4double field  = factor * fPolUnit.dot(n.cross((n - beta).cross(betaDot)));
+
+  // step duration and midpoint as seen at the antenna
+  G4double dtObs = kappa * dt;
+  G4double tObs  = 0.5 * (pre->GetGlobalTime() + post->GetGlobalTime()) + dist / c_light;
+
+  if(beta0.angle(beta1) > kMaxTurn || dtObs > fBinWidth) ++fUndersampled;
+
+  auto bin = (G4long) std::floor((tObs - fWindowStart) / fBinWidth);
+  if(bin < 0 || bin >= (G4long) fNSamples)
+  {
+    ++fOutOfWindow;
+    return;
+  }
+
+  std::size_t primary = SETrackInformation::GetPrimary(step->GetTrack());
+  if(primary >= fSamples.size()) fSamples.resize(primary + 1);
+  auto& samples = fSamples[primary];
+  if(samples.empty()) samples.assign(fNSamples, std::complex<G4double>(0., 0.));
+
+  // down-mix and integrate over the step, field constant within the step:
+  // int exp(-i w t) dt = exp(-i w tObs) * dtObs * sinc(w dtObs / 2)
+  G4double half  = 0.5 * fOmegaLO * dtObs;
+  G4double sinc  = (half > 1.e-8) ? std::sin(half) / half : 1.;
+  G4double phase = -fOmegaLO * tObs;
+  samples[bin] += (field * dtObs * sinc / fBinWidth)
+                   * std::complex<G4double>(std::cos(phase), std::sin(phase));
+}
+
+void SERadiationSignal::EndOfEvent(G4int eventID)
+{
+  if(!fActive) return;
+
+  if(fUndersampled > 0 && !fWarned)
+  {
+    G4ExceptionDescription msg;
+    msg << fUndersampled << " steps in event " << eventID
+        << " undersample the cyclotron motion or the output bins;" << G4endl
+        << "limit the step length in the gas to resolve the signal."
+        << " Further warnings suppressed.";
+    G4Exception("SERadiationSignal::EndOfEvent()",
+      "SE0002", JustWarning, msg);
+    fWarned = true;
+  }
+  // write non-empty bins only, per primary under its virtual event ID
+  auto  analysisManager = G4AnalysisManager::Instance();
+  G4int subEvent        = SESecondaryOffload::SubEvent();
+  for(std::size_t primary = 0; primary < fSamples.size(); ++primary)
+  {
+    const auto& samples = fSamples[primary];
+    if(samples.empty()) continue;
+
+    G4int virtualID = SETrackInformation::VirtualEventID(eventID, (G4int) primary);
+    for(std::size_t k = 0; k < samples.size(); ++k)
+    {
+      const auto& s = samples[k];
+      if(s.real() == 0. && s.imag() == 0.) continue;
+
+      analysisManager->FillNtupleIColumn(2, 0, virtualID);
+      analysisManager->FillNtupleDColumn(2, 1, (fWindowStart + (k + 0.5) * fBinWidth) / ns);
+      analysisManager->FillNtupleDColumn(2, 2, s.real() / (volt / m));
+      analysisManager->FillNtupleDColumn(2, 3, s.imag() / (volt / m));
+      analysisManager->FillNtupleIColumn(2, 4, subEvent);
+      analysisManager->AddNtupleRow(2);
+    }
+  }
+}
+
+void SERadiationSignal::DefineCommands()
+{
+  // Define /SE/signal command directory using generic messenger class
+  fMessenger =
+    new G4GenericMessenger(this, "/SE/signal/", "Radiation signal synthesis");
+
+  auto& activeCmd = fMessenger->DeclareProperty("enable", fActive,
+                                                "Accumulate the antenna signal.");
+  activeCmd.SetParameterName("flag", true);
+  activeCmd.SetDefaultValue("true");
+
+  fMessenger->DeclarePropertyWithUnit("antenna", "mm", fAntennaPos,
+                                      "Antenna position.");
+
+  fMessenger->DeclareProperty("polarisation", fPolarisation,
+                              "Antenna polarisation direction.");
+
+  auto& loCmd = fMessenger->DeclareProperty("loFrequency", fLOFrequency,
+                                            "Local oscillator frequency [GHz].");
+  loCmd.SetParameterName("f", true);
+  loCmd.SetRange("f>=0.");
+  loCmd.SetDefaultValue("26.5");
+
+  auto& rateCmd = fMessenger->DeclareProperty("sampleRate", fSampleRate,
+                                              "Output sample rate after down-mixing [MHz].");
+  rateCmd.SetParameterName("r", true);
+  rateCmd.SetRange("r>0.");
+  rateCmd.SetDefaultValue("1000.");
+
+  auto& nCmd = fMessenger->DeclareProperty("samples", fNSamples,
+                                           "Number of output samples per event.");
+  nCmd.SetParameterName("n", true);
+  nCmd.SetRange("n>0");
+  nCmd.SetDefaultValue("8192");
+
+  fMessenger->DeclarePropertyWithUnit("windowStart", "ns", fWindowStart,
+                                      "Antenna time of the first output sample.");
+}
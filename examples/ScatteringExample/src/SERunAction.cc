@@ -1,16 +1,31 @@
 #include "SERunAction.hh"
+#include "SEDetectorConstruction.hh"
 #include "SEEventAction.hh"
+#include "SEFieldTuner.hh"
+#include "SEPrimaryGeneratorAction.hh"
+#include "SERadiationSignal.hh"
+#include "SESecondaryOffload.hh"
+#include "QTNMStackingAction.hh"
+#include "QTNMStepMonitor.hh"
+#include "QTNMTelemetry.hh"
 #include "g4root.hh"
 
+#include "G4AccumulableManager.hh"
 #include "G4Run.hh"
 #include "G4RunManager.hh"
+#include "G4TransportationManager.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4UnitsTable.hh"
 
-SERunAction::SERunAction(SEEventAction* eventAction, G4String name)
+#include <algorithm>
+#include <cmath>
+
+SERunAction::SERunAction(SEEventAction* eventAction, G4String name,
+                         SEPrimaryGeneratorAction* primary)
 : G4UserRunAction()
 , fEventAction(eventAction)
 , fout(std::move(name))
+, fPrimary(primary)
 {
   // Create analysis manager
   auto analysisManager = G4AnalysisManager::Instance();
@@ -28,6 +43,8 @@ SERunAction::SERunAction(SEEventAction* eventAction, G4String name)
   analysisManager->CreateNtupleDColumn("Time");
   analysisManager->CreateNtupleIColumn("HitID");
   analysisManager->CreateNtupleIColumn("ParentID");
+  analysisManager->CreateNtupleDColumn("Weight");
+  analysisManager->CreateNtupleIColumn("SubEvent");
   analysisManager->FinishNtuple();
 
   analysisManager->CreateNtuple("Watch", "Timing");
@@ -36,23 +53,88 @@ SERunAction::SERunAction(SEEventAction* eventAction, G4String name)
   analysisManager->CreateNtupleDColumn("ExitTime");
   analysisManager->CreateNtupleDColumn("Posx");
   analysisManager->CreateNtupleDColumn("Posy");
+  analysisManager->CreateNtupleDColumn("Weight");
+  analysisManager->CreateNtupleIColumn("SubEvent");
+  analysisManager->FinishNtuple();
+
+  analysisManager->CreateNtuple("Signal", "Antenna");
+  analysisManager->CreateNtupleIColumn("EventID");
+  analysisManager->CreateNtupleDColumn("Time");
+  analysisManager->CreateNtupleDColumn("Re");
+  analysisManager->CreateNtupleDColumn("Im");
+  analysisManager->CreateNtupleIColumn("SubEvent");
+  analysisManager->FinishNtuple();
+
+  analysisManager->CreateNtuple("Trap", "Trapping");
+  analysisManager->CreateNtupleIColumn("EventID");
+  analysisManager->CreateNtupleIColumn("TrackID");
+  analysisManager->CreateNtupleIColumn("Trapped");
+  analysisManager->CreateNtupleIColumn("Bounces");
+  analysisManager->CreateNtupleDColumn("Pitch");
+  analysisManager->CreateNtupleDColumn("Period");
+  analysisManager->CreateNtupleIColumn("SubEvent");
   analysisManager->FinishNtuple();
+
+  // Time window statistics
+  auto accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->RegisterAccumulable(fKilled);
+  accumulableManager->RegisterAccumulable(fStepsSaved);
+  accumulableManager->RegisterAccumulable(fTimeSaved);
+
+  DefineCommands();
+}
+
+SERunAction::~SERunAction()
+{
+  delete fMessenger;
+  delete G4AnalysisManager::Instance();
 }
 
-SERunAction::~SERunAction() { delete G4AnalysisManager::Instance(); }
+void SERunAction::AddTimeCut(G4double stepsSaved, G4double timeSaved)
+{
+  fKilled     += 1;
+  fStepsSaved += stepsSaved;
+  fTimeSaved  += timeSaved;
+}
 
-void SERunAction::BeginOfRunAction(const G4Run* /*run*/)
+void SERunAction::BeginOfRunAction(const G4Run* run)
 {
+  // progress and throughput, workers only count events
+  if(IsMaster())
+  {
+    QTNMTelemetry::SetInterval(fProgress);
+    QTNMTelemetry::BeginOfRun(run->GetNumberOfEventToBeProcessed());
+  }
+
+  // Field propagation accuracy, after any field change by macro
+  // (the shared detector is visible from worker run managers)
+  auto detector = static_cast<const SEDetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  detector->GetFieldTuner()->Apply(
+    G4TransportationManager::GetTransportationManager()->GetFieldManager());
+  detector->SetupVolumeFields();
+
+  // Geometry may have changed since the last run
+  if(fPrimary) fPrimary->UpdateGeometry();
+
+  G4AccumulableManager::Instance()->Reset();
+
   // Get analysis manager
   auto analysisManager = G4AnalysisManager::Instance();
 
   // Open an output file
   //
   analysisManager->OpenFile(fout);
+
+  // secondaries may be offloaded until the last worker leaves the run
+  if(!IsMaster()) SESecondaryOffload::BeginOfRun();
 }
 
 void SERunAction::EndOfRunAction(const G4Run* /*run*/)
 {
+  // track offloaded secondaries while other threads finish their events
+  if(!IsMaster()) SESecondaryOffload::EndOfRun();
+
   // Get analysis manager
   auto analysisManager = G4AnalysisManager::Instance();
 
@@ -60,4 +142,61 @@ void SERunAction::EndOfRunAction(const G4Run* /*run*/)
   //
   analysisManager->Write();
   analysisManager->CloseFile();
+
+  // Time window report, merged over threads
+  G4AccumulableManager::Instance()->Merge();
+  if(IsMaster() && fTimeWindow > 0.)
+  {
+    G4cout << ">>> Time window " << G4BestUnit(fTimeWindow, "Time") << ": "
+           << fKilled.GetValue() << " tracks killed, estimated "
+           << fStepsSaved.GetValue() << " steps and "
+           << G4BestUnit(fTimeSaved.GetValue(), "Time")
+           << " of tracking time saved." << G4endl;
+  }
+
+  // weighted gas energy deposit, to check biased against analog runs
+  G4int nEvents = fEventAction->GetEdepEvents();
+  if(IsMaster() && nEvents > 0)
+  {
+    G4double mean  = fEventAction->GetEdepSum() / nEvents;
+    G4double var   = fEventAction->GetEdepSum2() / nEvents - mean * mean;
+    G4double error = std::sqrt(std::max(var, 0.) / nEvents);
+    auto precision = G4cout.precision(1);
+    G4cout << ">>> Gas weighted energy deposit per event: " << std::fixed
+           << mean / eV << " +- " << error / eV << " eV" << std::defaultfloat << G4endl;
+    G4cout.precision(precision);
+  }
+
+  // stacking rule counts and step statistics, workers end their runs first
+  QTNMStackingAction::Flush();
+  if(IsMaster()) QTNMStackingAction::Report();
+  QTNMStepMonitor::Flush();
+  if(IsMaster()) QTNMStepMonitor::Report();
+  if(IsMaster()) SESecondaryOffload::Report();
+  SERadiationSignal::Flush();
+  if(IsMaster()) SERadiationSignal::Report();
+
+  if(IsMaster()) QTNMTelemetry::EndOfRun(fSummary);
+}
+
+void SERunAction::DefineCommands()
+{
+  // Define /SE/run command directory using generic messenger class
+  fMessenger = new G4GenericMessenger(this, "/SE/run/", "Run control");
+
+  auto& windowCmd = fMessenger->DeclarePropertyWithUnit("timeWindow", "ns", fTimeWindow,
+                                                        "Kill tracks beyond this global time, 0 for none.");
+  windowCmd.SetParameterName("t", false);
+  windowCmd.SetRange("t>=0.");
+  windowCmd.SetStates(G4State_PreInit, G4State_Idle);
+
+  auto& progressCmd = fMessenger->DeclareProperty("progress", fProgress,
+                                                  "Seconds between progress lines, 0 for none.");
+  progressCmd.SetParameterName("s", false);
+  progressCmd.SetRange("s>=0.");
+  progressCmd.SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("summary", fSummary,
+                              "Write a JSON run summary to this file at the end of a run, none for none.")
+    .SetStates(G4State_PreInit, G4State_Idle);
 }
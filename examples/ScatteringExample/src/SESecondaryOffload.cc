@@ -0,0 +1,203 @@
+#include "SESecondaryOffload.hh"
+#include "SETrackInformation.hh"
+#include "QTNMEventSeeding.hh"
+
+#include <atomic>
+#include <deque>
+#include <map>
+
+#include "G4AutoLock.hh"
+#include "G4Event.hh"
+#include "G4EventManager.hh"
+#include "G4MTRunManager.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4TaskRunManager.hh"
+#include "G4Threading.hh"
+#include "G4Track.hh"
+#include "G4ios.hh"
+
+namespace
+{
+  G4Mutex offloadMutex = G4MUTEX_INITIALIZER;
+  G4Condition offloadCondition;
+
+  // shared between workers, under offloadMutex
+  std::deque<SESecondaryOffload::Item> queue;
+  G4int  producers = 0;   // workers still in their event loop
+  G4int  waiting   = 0;   // workers past their event loop, not tracking
+  G4long offloaded = 0;
+  G4long tracked   = 0;
+  G4long moved     = 0;   // tracked by another thread than the creator
+
+  // events with sub-events, collected until all of their pieces ended
+  struct Pieces
+  {
+    G4double sum  = 0.;
+    G4int    open = 0;  // sub-events not ended, less before the event ends
+  };
+  std::map<G4int, Pieces> pieces;
+
+  // per thread
+  G4ThreadLocal G4bool canOffload = false;
+  G4ThreadLocal G4int  subEvents  = 0;
+  G4ThreadLocal const SESecondaryOffload::Item* current = nullptr;
+
+  // copy of waiting, read without the lock for every candidate secondary
+  std::atomic<G4int> idle(0);
+
+  std::atomic<G4bool> warned(false);
+}
+
+
+void SESecondaryOffload::BeginOfRun()
+{
+  // other threads must be able to pick the queue up in their run
+  // termination, which tasking workers only reach once all events are done
+  auto master = G4MTRunManager::GetMasterRunManager();
+  canOffload  = master && !dynamic_cast<G4TaskRunManager*>(master);
+
+  G4AutoLock lock(&offloadMutex);
+  ++producers;
+}
+
+void SESecondaryOffload::BeginOfEvent()
+{
+  subEvents = 0;
+}
+
+G4bool SESecondaryOffload::Offload(const G4Track* track)
+{
+  if(current) return false;  // sub-events are tracked in one piece
+  if(!canOffload)
+  {
+    if(!warned.exchange(true))
+      G4Exception("SESecondaryOffload::Offload()", "SE0007", JustWarning,
+                  "Secondary offload needs the MT run manager, secondaries are stacked as usual.");
+    return false;
+  }
+
+  // only hand over to a thread with nothing else to do; while all are
+  // busy the secondary is stacked locally, the queue never outgrows them
+  if(idle.load(std::memory_order_relaxed) == 0) return false;
+
+  Item item;
+  item.eventID   = G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID();
+  item.primary   = SETrackInformation::GetPrimary(track);
+  item.thread    = G4Threading::G4GetThreadId();
+  item.particle  = track->GetDefinition();
+  item.energy    = track->GetKineticEnergy();
+  item.position  = track->GetPosition();
+  item.direction = track->GetMomentumDirection();
+  item.time      = track->GetGlobalTime();
+  item.weight    = track->GetWeight();
+
+  G4AutoLock lock(&offloadMutex);
+  if((G4int) queue.size() >= waiting) return false;
+  item.subEvent = ++subEvents;
+  queue.push_back(item);
+  ++offloaded;
+  G4CONDITIONNOTIFY(&offloadCondition);
+  return true;
+}
+
+void SESecondaryOffload::EndOfRun()
+{
+  G4AutoLock lock(&offloadMutex);
+  --producers;
+  idle.store(++waiting);
+  G4CONDITIONBROADCAST(&offloadCondition);
+
+  while(true)
+  {
+    G4CONDITIONWAITLAMBDA(&offloadCondition, &lock,
+                          [] { return !queue.empty() || producers <= 0; });
+    if(queue.empty()) break;
+
+    Item item = queue.front();
+    queue.pop_front();
+    idle.store(--waiting);
+    ++tracked;
+    if(item.thread != G4Threading::G4GetThreadId()) ++moved;
+
+    lock.unlock();
+    Track(item);
+    lock.lock();
+    idle.store(++waiting);
+  }
+  idle.store(--waiting);
+}
+
+void SESecondaryOffload::Track(const Item& item)
+{
+  auto particle = new G4PrimaryParticle(item.particle);
+  particle->SetKineticEnergy(item.energy);
+  particle->SetMomentumDirection(item.direction);
+  particle->SetWeight(item.weight);
+  auto vertex = new G4PrimaryVertex(item.position, item.time);
+  vertex->SetPrimary(particle);
+
+  // same ID as the event the secondary came from
+  auto event = new G4Event(item.eventID);
+  event->AddPrimaryVertex(vertex);
+  QTNMEventSeeding::SeedEvent(event, item.subEvent);
+
+  current = &item;
+  G4EventManager::GetEventManager()->ProcessOneEvent(event);
+  current = nullptr;
+  delete event;
+}
+
+G4bool SESecondaryOffload::InSubEvent()
+{
+  return current != nullptr;
+}
+
+G4int SESecondaryOffload::SubEvent()
+{
+  return current ? current->subEvent : 0;
+}
+
+G4int SESecondaryOffload::Primary()
+{
+  return current ? current->primary : 0;
+}
+
+G4bool SESecondaryOffload::IsPrimary(const G4Track* track)
+{
+  return track->GetParentID() == 0 && !current;
+}
+
+G4bool SESecondaryOffload::Collect(G4int eventID, G4double value, G4double& total)
+{
+  // an event without sub-events is complete at its end
+  if(!current && subEvents == 0)
+  {
+    total = value;
+    return true;
+  }
+
+  // the event adds its number of sub-events, each sub-event takes one
+  // off, in either order
+  G4AutoLock lock(&offloadMutex);
+  auto& entry = pieces[eventID];
+  entry.sum += value;
+  entry.open += current ? -1 : subEvents;
+  if(entry.open != 0) return false;
+
+  total = entry.sum;
+  pieces.erase(eventID);
+  return true;
+}
+
+void SESecondaryOffload::Report()
+{
+  G4AutoLock lock(&offloadMutex);
+  if(offloaded > 0)
+    G4cout << ">>> Secondary offload: " << offloaded << " secondaries queued, "
+           << tracked << " tracked as sub-events, " << moved
+           << " of them by another thread." << G4endl;
+  offloaded = 0;
+  tracked   = 0;
+  moved     = 0;
+}
@@ -0,0 +1,58 @@
+#include "SEStackingAction.hh"
+#include "SESecondaryOffload.hh"
+
+#include "G4LogicalVolume.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+
+
+SEStackingAction::SEStackingAction()
+: QTNMStackingAction("/SE/stack/")
+{
+  DefineCommands();
+}
+
+SEStackingAction::~SEStackingAction()
+{
+  delete fMessenger;
+}
+
+G4ClassificationOfNewTrack SEStackingAction::ClassifyNewTrack(const G4Track* track)
+{
+  G4ClassificationOfNewTrack classification = QTNMStackingAction::ClassifyNewTrack(track);
+  if(!fOffload || classification != fUrgent || track->GetParentID() == 0)
+    return classification;
+  if(track->GetKineticEnergy() < fMinEnergy) return classification;
+
+  // created in the offload volume
+  auto volume = track->GetVolume();
+  if(!volume || volume->GetLogicalVolume()->GetName() != fVolume) return classification;
+
+  return SESecondaryOffload::Offload(track) ? fKill : classification;
+}
+
+void SEStackingAction::PrepareNewEvent()
+{
+  SESecondaryOffload::BeginOfEvent();
+}
+
+void SEStackingAction::DefineCommands()
+{
+  // Define /SE/offload command directory using generic messenger class
+  fMessenger = new G4GenericMessenger(this, "/SE/offload/", "Secondary offload to other threads");
+
+  fMessenger->DeclareProperty("enable", fOffload,
+                              "Queue secondaries from the offload volume for other threads.")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  fMessenger->DeclareProperty("volume", fVolume,
+                              "Logical volume whose new secondaries are offloaded.")
+    .SetStates(G4State_PreInit, G4State_Idle);
+
+  auto& energyCmd = fMessenger->DeclarePropertyWithUnit("minEnergy", "keV", fMinEnergy,
+                                                        "Offload secondaries from this kinetic energy up.");
+  energyCmd.SetParameterName("e", false);
+  energyCmd.SetRange("e>=0.");
+  energyCmd.SetStates(G4State_PreInit, G4State_Idle);
+}
@@ -0,0 +1,56 @@
+#include "SESteppingAction.hh"
+#include "SERadiationSignal.hh"
+#include "SERunAction.hh"
+#include "SETrapMonitor.hh"
+
+#include <algorithm>
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+
+
+SESteppingAction::SESteppingAction(SERadiationSignal* signal, SERunAction* runAction)
+: G4UserSteppingAction()
+, fSignal(signal)
+, fTrap(new SETrapMonitor)
+, fRunAction(runAction)
+{}
+
+SESteppingAction::~SESteppingAction()
+{
+  delete fTrap;
+}
+
+void SESteppingAction::UserSteppingAction(const G4Step* step)
+{
+  if(fSignal->IsActive()) fSignal->AddStep(step);
+
+  G4double window = fRunAction->GetTimeWindow();
+  if(window > 0.)
+  {
+    auto track = step->GetTrack();
+    if(track->GetTrackStatus() != fAlive)
+    {
+      fTracks   += 1.;
+      fSteps    += track->GetCurrentStepNumber();
+      fDuration += track->GetLocalTime();
+    }
+    else if(step->GetPostStepPoint()->GetGlobalTime() > window)
+    {
+      track->SetTrackStatus(fStopAndKill);
+
+      // remaining work, estimated from the mean completed track
+      G4double steps = 0.;
+      G4double time  = 0.;
+      if(fTracks > 0.)
+      {
+        steps = std::max(0., fSteps / fTracks - track->GetCurrentStepNumber());
+        time  = std::max(0., fDuration / fTracks - track->GetLocalTime());
+      }
+      fRunAction->AddTimeCut(steps, time);
+    }
+  }
+
+  // last, may kill the track
+  if(fTrap->IsActive()) fTrap->ProcessStep(step);
+}
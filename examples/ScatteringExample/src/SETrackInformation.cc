@@ -0,0 +1,35 @@
+#include "SETrackInformation.hh"
+#include "SEPrimaryGeneratorAction.hh"
+
+#include "G4RunManager.hh"
+#include "G4Track.hh"
+
+#include <limits>
+
+G4ThreadLocal G4Allocator<SETrackInformation>* SETrackInformationAllocator=0;
+
+G4int SETrackInformation::GetPrimary(const G4Track* track)
+{
+  auto info = static_cast<const SETrackInformation*>(track->GetUserInformation());
+  return info ? info->GetPrimary() : 0;
+}
+
+G4int SETrackInformation::VirtualEventID(G4int eventID, G4int primary)
+{
+  // generator of this thread
+  auto generator = static_cast<const SEPrimaryGeneratorAction*>(
+    G4RunManager::GetRunManager()->GetUserPrimaryGeneratorAction());
+  G4int nPrimaries = generator ? generator->GetPrimariesPerEvent() : 1;
+
+  // the EventID columns are 32 bit
+  G4long virtualID = (G4long) eventID * nPrimaries + primary;
+  if(virtualID > std::numeric_limits<G4int>::max())
+  {
+    G4ExceptionDescription msg;
+    msg << "Virtual event ID " << virtualID << " of event " << eventID << " with "
+        << nPrimaries << " primaries is beyond the 32 bit EventID columns;"
+        << " use fewer events or primaries per event.";
+    G4Exception("SETrackInformation::VirtualEventID()", "SE0008", FatalException, msg);
+  }
+  return (G4int) virtualID;
+}
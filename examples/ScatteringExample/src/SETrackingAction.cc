@@ -0,0 +1,41 @@
+#include "SETrackingAction.hh"
+#include "SEPrimaryGeneratorAction.hh"
+#include "SESecondaryOffload.hh"
+#include "SETrackInformation.hh"
+
+#include "G4Track.hh"
+#include "G4TrackingManager.hh"
+
+
+SETrackingAction::SETrackingAction(SEPrimaryGeneratorAction* primary)
+: G4UserTrackingAction()
+, fPrimary(primary)
+{}
+
+void SETrackingAction::PreUserTrackingAction(const G4Track* track)
+{
+  if(fPrimary->GetPrimariesPerEvent() <= 1) return;
+
+  // primaries are numbered in the order they were generated, an offloaded
+  // secondary keeps the index of the primary it descends from
+  if(track->GetParentID() == 0 && !track->GetUserInformation())
+  {
+    G4int primary = SESecondaryOffload::InSubEvent() ? SESecondaryOffload::Primary()
+                                                     : track->GetTrackID() - 1;
+    track->SetUserInformation(new SETrackInformation(primary));
+  }
+}
+
+void SETrackingAction::PostUserTrackingAction(const G4Track* track)
+{
+  auto info = static_cast<SETrackInformation*>(track->GetUserInformation());
+  if(!info) return;
+
+  auto secondaries = fpTrackingManager->GimmeSecondaries();
+  if(!secondaries) return;
+  for(auto secondary : *secondaries)
+  {
+    if(!secondary->GetUserInformation())
+      secondary->SetUserInformation(new SETrackInformation(info->GetPrimary()));
+  }
+}
@@ -0,0 +1,166 @@
+#include "SETrapMonitor.hh"
+#include "SESecondaryOffload.hh"
+#include "SETrackInformation.hh"
+#include "QTNMEventSeeding.hh"
+#include "g4root.hh"
+
+#include <cmath>
+
+#include "G4Event.hh"
+#include "G4EventManager.hh"
+#include "G4Field.hh"
+#include "G4FieldManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4Track.hh"
+#include "G4TransportationManager.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4SystemOfUnits.hh"
+
+
+SETrapMonitor::SETrapMonitor()
+{
+  DefineCommands();
+}
+
+SETrapMonitor::~SETrapMonitor()
+{
+  delete fMessenger;
+}
+
+G4ThreeVector SETrapMonitor::FieldAt(const G4Step* step, const G4ThreeVector& pos,
+                                     G4double time) const
+{
+  // volume field manager if any, else the global one
+  G4FieldManager* fieldManager = nullptr;
+  auto volume = step->GetPreStepPoint()->GetPhysicalVolume();
+  if(volume) fieldManager = volume->GetLogicalVolume()->GetFieldManager();
+  if(!fieldManager)
+    fieldManager = G4TransportationManager::GetTransportationManager()->GetFieldManager();
+
+  const G4Field* field = fieldManager ? fieldManager->GetDetectorField() : nullptr;
+  if(!field) return G4ThreeVector();
+
+  G4double point[4] = { pos.x(), pos.y(), pos.z(), time };
+  G4double value[6] = { 0., 0., 0., 0., 0., 0. };
+  field->GetFieldValue(point, value);
+  return G4ThreeVector(value[0], value[1], value[2]);
+}
+
+void SETrapMonitor::ProcessStep(const G4Step* step)
+{
+  auto track = step->GetTrack();
+  if(fPrimariesOnly && !SESecondaryOffload::IsPrimary(track)) return;
+  if(track->GetDefinition()->GetPDGCharge() == 0.) return;
+
+  // new track
+  if(track->GetCurrentStepNumber() == 1)
+  {
+    fSign    = 0;
+    fCount   = 0;
+    fTrapped = false;
+  }
+
+  auto pre  = step->GetPreStepPoint();
+  auto post = step->GetPostStepPoint();
+
+  G4ThreeVector field = FieldAt(step, post->GetPosition(), post->GetGlobalTime());
+  if(field.mag2() > 0.)
+  {
+    // momentum along the field, sign change at an axial turning point
+    G4double par  = post->GetMomentum().dot(field.unit());
+    G4int    sign = (par >= 0.) ? 1 : -1;
+    if(fSign != 0 && sign != fSign)
+    {
+      G4double frac = fLastPar / (fLastPar - par);
+      G4double t    = pre->GetGlobalTime()
+                      + frac * (post->GetGlobalTime() - pre->GetGlobalTime());
+      if(++fCount == 1) fFirstTime = t;
+      fLastTime = t;
+    }
+    fSign    = sign;
+    fLastPar = par;
+
+    if(!fTrapped && fCount >= fBounces)
+    {
+      fTrapped = true;
+      Record(track, true);
+      if(fKill) track->SetTrackStatus(fStopAndKill);
+      return;
+    }
+  }
+
+  if(!fTrapped && track->GetTrackStatus() != fAlive) Record(track, false);
+}
+
+void SETrapMonitor::Record(const G4Track* track, G4bool trapped)
+{
+  // pitch angle at the track vertex, folded into [0, 90] deg
+  G4double pitch = 0.;
+  auto fieldManager = G4TransportationManager::GetTransportationManager()->GetFieldManager();
+  const G4Field* field = fieldManager ? fieldManager->GetDetectorField() : nullptr;
+  if(field)
+  {
+    G4ThreeVector pos = track->GetVertexPosition();
+    G4double point[4] = { pos.x(), pos.y(), pos.z(), 0. };
+    G4double value[6] = { 0., 0., 0., 0., 0., 0. };
+    field->GetFieldValue(point, value);
+    G4ThreeVector b(value[0], value[1], value[2]);
+    if(b.mag2() > 0.)
+    {
+      pitch = track->GetVertexMomentumDirection().angle(b);
+      if(pitch > halfpi) pitch = pi - pitch;
+    }
+  }
+
+  // two turning points per axial period
+  G4double period = (fCount > 1) ? 2. * (fLastTime - fFirstTime) / (fCount - 1) : 0.;
+
+  G4int eventID = (G4int) QTNMEventSeeding::EventID(G4EventManager::GetEventManager()->GetConstCurrentEvent());
+  auto analysisManager = G4AnalysisManager::Instance();
+  analysisManager->FillNtupleIColumn(3, 0, SETrackInformation::VirtualEventID(
+                                             eventID, SETrackInformation::GetPrimary(track)));
+  analysisManager->FillNtupleIColumn(3, 1, track->GetTrackID());
+  analysisManager->FillNtupleIColumn(3, 2, trapped ? 1 : 0);
+  analysisManager->FillNtupleIColumn(3, 3, fCount);
+  analysisManager->FillNtupleDColumn(3, 4, pitch / deg);
+  analysisManager->FillNtupleDColumn(3, 5, period / ns);
+  analysisManager->FillNtupleIColumn(3, 6, SESecondaryOffload::SubEvent());
+  analysisManager->AddNtupleRow(3);
+}
+
+void SETrapMonitor::SetAction(const G4String& action)
+{
+  fKill = (action == "kill");
+}
+
+void SETrapMonitor::DefineCommands()
+{
+  // Define /SE/trap command directory using generic messenger class
+  fMessenger =
+    new G4GenericMessenger(this, "/SE/trap/", "Trapped electron detection");
+
+  auto& activeCmd = fMessenger->DeclareProperty("enable", fActive,
+                                                "Count axial bounces of charged tracks.");
+  activeCmd.SetParameterName("flag", true);
+  activeCmd.SetDefaultValue("true");
+
+  auto& bounceCmd = fMessenger->DeclareProperty("bounces", fBounces,
+                                                "Turning points before a track counts as trapped.");
+  bounceCmd.SetParameterName("n", true);
+  bounceCmd.SetRange("n>=2");
+  bounceCmd.SetDefaultValue("4");
+
+  fMessenger->DeclareMethod("action", &SETrapMonitor::SetAction)
+    .SetGuidance("Action on trapped tracks")
+    .SetGuidance("kill = record and stop tracking")
+    .SetGuidance("flag = record and keep tracking")
+    .SetCandidates("kill flag");
+
+  auto& primCmd = fMessenger->DeclareProperty("primariesOnly", fPrimariesOnly,
+                                              "Monitor primary tracks only.");
+  primCmd.SetParameterName("flag", true);
+  primCmd.SetDefaultValue("true");
+}
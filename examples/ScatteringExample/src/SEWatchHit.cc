@@ -6,7 +6,9 @@ SEWatchHit::SEWatchHit()
  : G4VHit(),
    fHid(0),
    fTime(0.),
-   fPos(G4ThreeVector())
+   fPos(G4ThreeVector()),
+   fPrimary(0),
+   fWeight(1.)
 {}
 
 SEWatchHit::~SEWatchHit() {}
@@ -17,6 +19,8 @@ SEWatchHit::SEWatchHit(const SEWatchHit& right)
   fHid       = right.fHid;
   fTime      = right.fTime;
   fPos       = right.fPos;
+  fPrimary   = right.fPrimary;
+  fWeight    = right.fWeight;
 }
 
 const SEWatchHit& SEWatchHit::operator=(const SEWatchHit& right)
@@ -24,6 +28,8 @@ const SEWatchHit& SEWatchHit::operator=(const SEWatchHit& right)
   fHid       = right.fHid;
   fTime      = right.fTime;
   fPos       = right.fPos;
+  fPrimary   = right.fPrimary;
+  fWeight    = right.fWeight;
 
   return *this;
 }
@@ -1,4 +1,5 @@
 #include "SEWatchSD.hh"
+#include "SETrackInformation.hh"
 #include "G4HCofThisEvent.hh"
 #include "G4Step.hh"
 #include "G4ThreeVector.hh"
@@ -46,6 +47,9 @@ G4bool SEWatchSD::ProcessHits(G4Step* aStep,
   newHit->SetHid(aStep->GetTrack()->GetTrackID());
   newHit->SetTime(aStep->GetTrack()->GetGlobalTime());
   newHit->SetPos(aStep->GetPreStepPoint()->GetPosition());
+  newHit->SetPrimary(SETrackInformation::GetPrimary(aStep->GetTrack()));
+  // weight after the step: a biased interaction sets it in this step
+  newHit->SetWeight(aStep->GetTrack()->GetWeight());
 
   fHitsCollection->insert( newHit );
 
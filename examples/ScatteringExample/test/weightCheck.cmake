@@ -0,0 +1,29 @@
+# Biased against analog weighted gas energy deposit per event
+#
+# cmake -DAPP=<scattering> -DDIR=<test dir> -P weightCheck.cmake
+# Runs weights-analog.mac and weights-biased.mac with the same seed and
+# fails unless the means agree within four combined standard errors.
+
+foreach(mode analog biased)
+  execute_process(COMMAND ${APP} --biasing -s 1 -t 1 -o weights-${mode}.root
+                          -m ${DIR}/weights-${mode}.mac
+                  OUTPUT_VARIABLE out RESULT_VARIABLE status)
+  if(NOT status EQUAL 0)
+    message(FATAL_ERROR "${mode} run failed (${status})")
+  endif()
+  # printed with one decimal in eV, compared in 0.1 eV
+  if(NOT out MATCHES "weighted energy deposit per event: ([0-9]+)\\.([0-9]) \\+- ([0-9]+)\\.([0-9]) eV")
+    message(FATAL_ERROR "no weighted deposit in the ${mode} run output")
+  endif()
+  set(mean_${mode} "${CMAKE_MATCH_1}${CMAKE_MATCH_2}")
+  set(error_${mode} "${CMAKE_MATCH_3}${CMAKE_MATCH_4}")
+  message(STATUS "${mode}: ${CMAKE_MATCH_1}.${CMAKE_MATCH_2} +- ${CMAKE_MATCH_3}.${CMAKE_MATCH_4} eV")
+endforeach()
+
+# (a - b)^2 <= 16 (ea^2 + eb^2), plus one unit for rounding
+math(EXPR diff "${mean_biased} - ${mean_analog}")
+math(EXPR lhs "${diff} * ${diff}")
+math(EXPR rhs "16 * (${error_analog} * ${error_analog} + ${error_biased} * ${error_biased}) + 1")
+if(lhs GREATER rhs)
+  message(FATAL_ERROR "biased and analog weighted deposits differ by more than 4 sigma")
+endif()